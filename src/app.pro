@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += core gui svg
+QT       += core gui svg concurrent
 CONFIG += c++14
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -17,6 +17,9 @@ TEMPLATE = app
 # deprecated API in order to know how to port your code away from it.
 DEFINES += QT_DEPRECATED_WARNINGS
 
+# Count heap allocations of blocks in profiler, replaces global operator new (qmake CONFIG+=profile_allocations).
+profile_allocations: DEFINES += BLOCK_PROFILE_ALLOCATIONS
+
 # You can also make your code fail to compile if you use deprecated APIs.
 # In order to do so, uncomment the following line.
 # You can also select to disable deprecated APIs only up to a certain version of Qt.
@@ -48,13 +51,29 @@ HEADERS += \
     app/core/blocks/vectinitblock.h \
     app/core/blocks/vectmagblock.h \
     app/core/base.h \
+    app/core/batchevaluator.h \
     app/core/block.h \
     app/core/blockmanager.h \
+    app/core/blockprofile.h \
+    app/core/blockscheduler.h \
+    app/core/cycledetector.h \
+    app/core/datacolumn.h \
+    app/core/debugsession.h \
+    app/core/evaluationplan.h \
     app/core/factoriable.h \
     app/core/factorybase.h \
     app/core/identified.h \
     app/core/join.h \
+    app/core/parallelevaluator.h \
+    app/core/planoptimizer.h \
+    app/core/portvaluestore.h \
+    app/core/schemecompiler.h \
     app/core/schemeio.h \
+    app/core/schemeprogram.h \
+    app/core/slotmap.h \
+    app/core/streamevaluator.h \
+    app/core/value.h \
+    app/core/vectorkernels.h \
     app/ui/container/blockcanvas.h \
     app/ui/container/blocksselection.h \
     app/ui/container/scrollarea.h \
@@ -84,11 +103,26 @@ SOURCES += \
     app/core/blocks/subblock.cpp \
     app/core/blocks/vectinitblock.cpp \
     app/core/blocks/vectmagblock.cpp \
+    app/core/batchevaluator.cpp \
     app/core/block.cpp \
     app/core/blockmanager.cpp \
+    app/core/blockprofile.cpp \
+    app/core/blockscheduler.cpp \
+    app/core/cycledetector.cpp \
+    app/core/datacolumn.cpp \
+    app/core/debugsession.cpp \
+    app/core/evaluationplan.cpp \
     app/core/identified.cpp \
     app/core/join.cpp \
+    app/core/parallelevaluator.cpp \
+    app/core/planoptimizer.cpp \
+    app/core/portvaluestore.cpp \
+    app/core/schemecompiler.cpp \
     app/core/schemeio.cpp \
+    app/core/schemeprogram.cpp \
+    app/core/streamevaluator.cpp \
+    app/core/value.cpp \
+    app/core/vectorkernels.cpp \
     app/ui/container/blockcanvas.cpp \
     app/ui/container/blocksselection.cpp \
     app/ui/container/scrollarea.cpp \
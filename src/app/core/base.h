@@ -13,6 +13,7 @@
 #include <cstddef>
 #include <QMap>
 #include <QVariant>
+#include "value.h"
 
 #define GET_OVERLOADED_MACRO34(_1, _2, _3, _4, NAME, ...) NAME
 #define GET_OVERLOADED_MACRO23(_1, _2, _3, NAME, ...) NAME
@@ -20,7 +21,5 @@
 
 using Identifier = unsigned int;
 using PortIdentifier = unsigned int;
-using DataValue = QVariant;
-using MappedDataValues = QMap<QString, DataValue>;
 
 #endif //ICP18_BASE_H
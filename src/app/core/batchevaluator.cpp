@@ -0,0 +1,150 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#include "batchevaluator.h"
+
+#include <QtGlobal>
+#include "blockmanager.h"
+
+BatchEvaluator::BatchEvaluator(const BlockManager* manager) : m_manager{manager}, m_optimizer{manager} {}
+
+bool BatchEvaluator::prepare() {
+    const EvaluationPlan &plan = m_manager->plan();
+    if (plan.hasCycle())
+        return false;
+
+    const int count = plan.order().length();
+    m_outputs.clear();
+    m_inputs.clear();
+    m_portSlots.clear();
+    m_variables.clear();
+    m_optimized = false;
+    m_literalRows = -1;
+    m_outputs.reserve(count);
+    m_inputs.resize(count);
+
+    for (int position = 0; position < count; position++) {
+        Block* block = m_manager->block(plan.handle(position));
+        m_outputs.append(DataColumn(block->outputPort()->type()));
+
+        const QList<BlockPort*> ports = block->inputPorts();
+        m_inputs[position].reserve(ports.length());
+        for (int i = 0; i < ports.length(); i++) {
+            m_inputs[position].append(DataColumn(ports.at(i)->type()));
+            m_portSlots.insert(ports.at(i), qMakePair(position, i));
+        }
+    }
+    return true;
+}
+
+void BatchEvaluator::setObserved(const QSet<Identifier> &blocks) {
+    m_optimizer.setObserved(blocks);
+    m_optimized = false;
+}
+
+DataColumn* BatchEvaluator::inputColumn(BlockPort* port) {
+    if (!m_portSlots.contains(port) || port->isConnected())
+        return nullptr;
+
+    const QPair<int, int> slot = m_portSlots.value(port);
+    m_variables.insert(port);
+    m_optimized = false;
+    return &m_inputs[slot.first][slot.second];
+}
+
+const PlanOptimizer &BatchEvaluator::optimizer() {
+    if (!m_optimized) {
+        m_optimizer.setVariables(m_variables);
+        m_optimizer.optimize();
+        m_optimized = true;
+        m_literalRows = -1;
+    }
+    return m_optimizer;
+}
+
+void BatchEvaluator::evaluateChunk(int rows) {
+    Q_ASSERT(rows <= BatchEvaluator::s_chunkRows);
+    const EvaluationPlan &plan = m_manager->plan();
+    const PlanOptimizer &optimizer = this->optimizer();
+    const bool refillLiterals = (rows != m_literalRows);
+
+    if (refillLiterals) {
+        for (int position = 0; position < plan.order().length(); position++) {
+            if (optimizer.isLive(position) && optimizer.isConstant(position))
+                m_outputs[position].fill(optimizer.constantValue(position), rows);
+        }
+    }
+
+    QList<const DataColumn*> columns;
+    for (int position: optimizer.schedule()) {
+        Block* block = m_manager->block(plan.handle(position));
+        const QVector<int> &sources = plan.inputSources(position);
+        const QList<BlockPort*> ports = block->inputPorts();
+
+        columns.clear();
+        for (int i = 0; i < ports.length(); i++) {
+            const int source = sources.value(i, -1);
+            if (source >= 0) {
+                columns.append(&m_outputs.at(optimizer.canonical(source)));
+                continue;
+            }
+
+            // literal values are constant over all rows, so they are broadcasted only when size changes
+            DataColumn &column = m_inputs[position][i];
+            if (refillLiterals && !m_variables.contains(ports.at(i)))
+                column.fill(ports.at(i)->value(), rows);
+            columns.append(&column);
+        }
+
+        ProfileScope scope{block};
+        block->evaluateColumns(columns, m_outputs[position], rows);
+    }
+    m_literalRows = rows;
+}
+
+const DataColumn &BatchEvaluator::outputColumn(Identifier blockId) const {
+    return m_outputs.at(m_optimizer.canonical(m_manager->plan().position(blockId)));
+}
+
+QMap<Identifier, DataColumn> BatchEvaluator::evaluate(const QMap<BlockPort*, DataColumn> &inputs, int rows) {
+    QMap<Identifier, DataColumn> results;
+    if (!this->prepare())
+        return results;
+
+    // chunks are sliced from columns without further checks, short or mistyped column would be read past its end
+    for (auto it = inputs.constBegin(); it != inputs.constEnd(); it++) {
+        const DataColumn &column = it.value();
+        const bool vector = it.key()->type() == Type::Vector;
+        if ((column.type() == Type::Vector) != vector || column.rows() < rows ||
+            (vector ? column.width() < 1 : column.width() != 1))
+            return results;
+    }
+
+    QList<QPair<DataColumn*, const DataColumn*> > variables;
+    for (auto it = inputs.constBegin(); it != inputs.constEnd(); it++) {
+        DataColumn* column = this->inputColumn(it.key());
+        if (column != nullptr)
+            variables.append(qMakePair(column, &it.value()));
+    }
+
+    const QList<Identifier> outputBlocks = this->optimizer().outputs();
+    for (Identifier blockId: outputBlocks)
+        results.insert(blockId, DataColumn(m_manager->block(blockId)->outputPort()->type()));
+
+    for (int first = 0; first < rows; first += BatchEvaluator::s_chunkRows) {
+        const int chunk = qMin(BatchEvaluator::s_chunkRows, rows - first);
+        for (auto variable: variables)
+            variable.first->slice(*variable.second, first, chunk);
+
+        this->evaluateChunk(chunk);
+        for (Identifier blockId: outputBlocks)
+            results[blockId].append(this->outputColumn(blockId), chunk);
+    }
+    return results;
+}
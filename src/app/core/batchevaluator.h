@@ -0,0 +1,95 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#ifndef BATCHEVALUATOR_H
+#define BATCHEVALUATOR_H
+
+#include <QHash>
+#include <QMap>
+#include <QPair>
+#include <QSet>
+#include <QVector>
+#include "base.h"
+#include "datacolumn.h"
+#include "planoptimizer.h"
+
+class BlockManager;
+class BlockPort;
+
+/**
+ * Evaluates scheme over many rows of input data, block by block on whole columns in chunks.
+ */
+class BatchEvaluator {
+    public:
+        /**
+         * Count of rows evaluated in one chunk, columns of one chunk fit in cache.
+         */
+        static constexpr int s_chunkRows = 1024;
+
+    private:
+        const BlockManager* m_manager;
+        QVector<DataColumn> m_outputs;
+        QVector<QVector<DataColumn> > m_inputs;
+        QHash<BlockPort*, QPair<int, int> > m_portSlots;
+        QSet<BlockPort*> m_variables;
+        PlanOptimizer m_optimizer;
+        bool m_optimized = false;
+        int m_literalRows = -1;
+
+    public:
+        /**
+         * Creates evaluator over scheme in manager.
+         * @param manager manager with scheme
+         */
+        explicit BatchEvaluator(const BlockManager* manager);
+
+        /**
+         * Allocates columns for current scheme, has to be called before evaluation.
+         * @return false if scheme is not acyclic
+         */
+        bool prepare();
+
+        /**
+         * Sets blocks, whose results are needed, empty means all blocks with unconnected output.
+         * @param blocks observed blocks
+         */
+        void setObserved(const QSet<Identifier> &blocks);
+        /**
+         * Marks free input port as variable and returns its chunk column to be filled by caller.
+         * @param port free input port
+         * @return column of port or nullptr if port is connected or unknown
+         */
+        DataColumn* inputColumn(BlockPort* port);
+        /**
+         * Optimizer of scheme for current variable ports, pass is rerun when ports changed.
+         * @return optimizer
+         */
+        const PlanOptimizer &optimizer();
+        /**
+         * Evaluates live variable blocks on first rows of chunk columns, constants are broadcasted.
+         * @param rows count of rows, at most chunk size
+         */
+        void evaluateChunk(int rows);
+        /**
+         * Returns output column of live block from last evaluated chunk, merged blocks share column.
+         * @param blockId block identifier
+         * @return output column
+         */
+        const DataColumn &outputColumn(Identifier blockId) const;
+
+        /**
+         * Evaluates whole input columns chunk by chunk.
+         * @param inputs columns for variable input ports
+         * @param rows count of rows to evaluate, every input column needs at least this many rows
+         * @return output columns of observed blocks, empty if scheme is cyclic or some input column does not fit its port
+         */
+        QMap<Identifier, DataColumn> evaluate(const QMap<BlockPort*, DataColumn> &inputs, int rows);
+};
+
+#endif // BATCHEVALUATOR_H
@@ -9,7 +9,11 @@
 
 #include "block.h"
 
+#include <QDataStream>
+
 QMap<QString, int> Block::s_blocksInputsCount;
+bool Block::s_profiling = false;
+bool Block::s_headless = false;
 
 void Block::setOutputPort(BlockPort* p) {
     p->setIsOutput(true);
@@ -17,29 +21,107 @@ void Block::setOutputPort(BlockPort* p) {
 }
 
 void Block::setInputPorts(const QList<BlockPort*> &ports) {
-    for (auto p: ports)
+    for (auto p: ports) {
         p->setIsOutput(false);
+        if (p->view() != nullptr)
+            connect(p->view(), &BlockPortView::valueEdited, this, [this]() {
+                emit this->inputEdited(this->id());
+            });
+    }
     m_inputPorts = ports;
 }
 
 Block::Block(QGraphicsWidget* parent) : QObject{}, Identified(), Factoriable(), FactoryBase<Block>() {
     m_parent = parent;
-    m_view = new BlockView(this, parent);
     m_outputPort = nullptr;
+    m_cache.setMaxCost(0);
+    if (Block::s_headless)
+        return;
 
+    m_view = new BlockView(this, parent);
     m_view->setBackgroundColor(QColor("#4c4c4c"));
     m_view->setBackgroundSelectionColor(QColor("#0f81bc"));
 
     connect(m_view, &BlockView::deleteRequest, this, &Block::deleteRequest);
+    connect(m_view, &BlockView::runToRequest, this, &Block::runToRequest);
+    connect(m_view, &BlockView::deleteItemsRequest, this, &Block::deleteItemsRequest);
 }
 
 Block::~Block() {
-    m_view->deleteLater();
+    if (m_view != nullptr)
+        m_view->deleteLater();
     delete m_outputPort;
     for (int i = 0; i < m_inputPorts.length(); i++)
         delete m_inputPorts[i];
 }
 
+void Block::evaluateColumns(const QList<const DataColumn*> &inputs, DataColumn &output, int rows) {
+    if (rows == 0) {
+        output.reset(output.width(), 0);
+        return;
+    }
+
+    QVector<Value> inputData;
+    for (int row = 0; row < rows; row++) {
+        inputData.clear();
+        for (auto column: inputs)
+            inputData.append(column->value(row));
+
+        const Value result = this->lookupEvaluate(inputData);
+        if (row == 0)
+            output.reset(result.length(), rows);
+        output.setValue(row, result);
+    }
+}
+
+Value Block::cachedEvaluate(const QVector<Value> &inputData) {
+    ProfileScope scope{this};
+    return this->lookupEvaluate(inputData);
+}
+
+Value Block::lookupEvaluate(const QVector<Value> &inputData) {
+    if (m_cache.maxCost() == 0)
+        return this->evaluate(inputData);
+
+    // serialized inputs are compared exactly, so colliding hashes cannot return wrong result
+    QByteArray key;
+    QDataStream stream{&key, QIODevice::WriteOnly};
+    stream << inputData;
+
+    const Value* cached = m_cache.object(key);
+    if (cached != nullptr) {
+        m_cacheHits++;
+        return *cached;
+    }
+
+    m_cacheMisses++;
+    const Value result = this->evaluate(inputData);
+    m_cache.insert(key, new Value(result));
+    return result;
+}
+
+void Block::setCacheLimit(int entries) {
+    m_cache.setMaxCost(entries);
+}
+
+int Block::cacheLimit() const {
+    return m_cache.maxCost();
+}
+
+quint64 Block::cacheHits() const {
+    return m_cacheHits;
+}
+
+quint64 Block::cacheMisses() const {
+    return m_cacheMisses;
+}
+
+void Block::clearCache() {
+    m_cache.clear();
+    m_cacheHits = 0;
+    m_cacheMisses = 0;
+}
+
 QList<BlockPort*> Block::inputPorts() const {
     return m_inputPorts;
 }
@@ -48,11 +130,12 @@ BlockPort* Block::outputPort() const {
     return m_outputPort;
 }
 
-bool Block::inputMatchesPorts(const QList<MappedDataValues> &inputData) const {
+bool Block::inputMatchesPorts(const QVector<Value> &inputData) const {
     bool matches = true;
     matches = matches && inputData.length() == m_inputPorts.length();
     for (int i = 0; i < m_inputPorts.length(); i++)
-        matches = matches && inputData.at(i).keys() == m_inputPorts.at(i)->labels();
+        matches = matches && inputData.at(i).isValid() &&
+                  inputData.at(i).isVector() == (m_inputPorts.at(i)->type() == Type::Vector);
     return matches;
 }
 
@@ -79,3 +162,60 @@ bool Block::validInputs() const {
     return valid;
 }
 
+QVector<Value> Block::inputValues() const {
+    QVector<Value> inputs;
+    inputs.reserve(m_inputPorts.length());
+    for (auto port: m_inputPorts)
+        inputs.append(port->value());
+    return inputs;
+}
+
+bool Block::breakpoint() const {
+    return m_breakpoint;
+}
+
+void Block::setBreakpoint(bool v) {
+    m_breakpoint = v;
+    if (m_view != nullptr)
+        m_view->update();
+}
+
+bool Block::headless() {
+    return Block::s_headless;
+}
+
+void Block::setHeadless(bool v) {
+    Block::s_headless = v;
+}
+
+QPointF Block::position() const {
+    return (m_view != nullptr) ? m_view->pos() : m_position;
+}
+
+void Block::setPosition(const QPointF &position) {
+    m_position = position;
+    if (m_view != nullptr)
+        m_view->setPos(position);
+}
+
+bool Block::profiling() {
+    return Block::s_profiling;
+}
+
+void Block::setProfiling(bool v) {
+    Block::s_profiling = v;
+}
+
+const BlockProfile &Block::profile() const {
+    return m_profile;
+}
+
+void Block::recordProfile(qint64 nanoseconds, quint64 allocations) {
+    m_profile.nanoseconds += nanoseconds;
+    m_profile.calls++;
+    m_profile.allocations += allocations;
+}
+
+void Block::resetProfile() {
+    m_profile = BlockProfile{};
+}
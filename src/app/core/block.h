@@ -11,11 +11,16 @@
 #define BLOCK_H
 
 
+#include <QByteArray>
+#include <QCache>
+#include <QPointF>
 #include "base.h"
+#include "blockprofile.h"
 #include "identified.h"
 #include "factoriable.h"
 #include "factorybase.h"
 #include "blocks/blockport.h"
+#include "datacolumn.h"
 #include "../ui/blockview.h"
 
 /**
@@ -30,6 +35,25 @@ class Block : public QObject, public Identified, public Factoriable, public Fact
         BlockPort* m_outputPort = nullptr;
         QList<BlockPort*> m_inputPorts;
         static QMap<QString, int> s_blocksInputsCount;
+        static bool s_profiling;
+        static bool s_headless;
+        QPointF m_position;
+
+        /**
+         * Results of already seen inputs, least recently used are evicted first.
+         */
+        QCache<QByteArray, Value> m_cache;
+        quint64 m_cacheHits = 0;
+        quint64 m_cacheMisses = 0;
+        bool m_breakpoint = false;
+        BlockProfile m_profile;
+
+        /**
+         * Evaluate block operation through result cache without profiling.
+         * @param inputData data to eval
+         * @return computed or cached value
+         */
+        Value lookupEvaluate(const QVector<Value> &inputData);
 
     protected:
         /**
@@ -52,7 +76,92 @@ class Block : public QObject, public Identified, public Factoriable, public Fact
          * @param inputData data to eval
          * @return computed value
          */
-        virtual MappedDataValues evaluate(const QList<MappedDataValues> &inputData) = 0;
+        virtual Value evaluate(const QVector<Value> &inputData) = 0;
+        /**
+         * Evaluate block operation over many rows at once, default implementation evaluates row by row.
+         * @param inputs column for each input port
+         * @param output column for result
+         * @param rows count of rows to evaluate
+         */
+        virtual void evaluateColumns(const QList<const DataColumn*> &inputs, DataColumn &output, int rows);
+        /**
+         * Evaluate block operation through result cache, cache is skipped if it has zero limit.
+         * @param inputData data to eval
+         * @return computed or cached value
+         */
+        Value cachedEvaluate(const QVector<Value> &inputData);
+
+        /**
+         * Sets maximal count of cached results, zero disables cache.
+         * @param entries count of results
+         */
+        void setCacheLimit(int entries);
+        /**
+         * Getter for maximal count of cached results.
+         * @return count of results
+         */
+        int cacheLimit() const;
+        /**
+         * Count of evaluations answered from cache.
+         * @return hits
+         */
+        quint64 cacheHits() const;
+        /**
+         * Count of evaluations missing in cache.
+         * @return misses
+         */
+        quint64 cacheMisses() const;
+        /**
+         * Drops all cached results and resets counters.
+         */
+        void clearCache();
+
+        /**
+         * Are blocks created without views?
+         * @return state
+         */
+        static bool headless();
+        /**
+         * Creates following blocks, their ports and joins without views, e.g. for command line evaluation.
+         * @param v state
+         */
+        static void setHeadless(bool v);
+        /**
+         * Position of block in canvas, kept in model for blocks without view.
+         * @return position
+         */
+        QPointF position() const;
+        /**
+         * Moves block in canvas.
+         * @param position new position
+         */
+        void setPosition(const QPointF &position);
+
+        /**
+         * Is profiling of evaluations enabled?
+         * @return state
+         */
+        static bool profiling();
+        /**
+         * Enables profiling of evaluations of all blocks.
+         * @param v state
+         */
+        static void setProfiling(bool v);
+        /**
+         * Getter for collected profile.
+         * @return profile
+         */
+        const BlockProfile &profile() const;
+        /**
+         * Adds one measured evaluation into profile.
+         * @param nanoseconds wall time
+         * @param allocations count of heap allocations
+         */
+        void recordProfile(qint64 nanoseconds, quint64 allocations);
+        /**
+         * Clears collected profile.
+         */
+        void resetProfile();
         /**
          * Getter for all input ports.
          * @return ports
@@ -69,7 +178,7 @@ class Block : public QObject, public Identified, public Factoriable, public Fact
          * @param inputData data to check
          * @return state, if is ok
          */
-        bool inputMatchesPorts(const QList<MappedDataValues> &inputData) const;
+        bool inputMatchesPorts(const QVector<Value> &inputData) const;
 
         /**
          * Registers new type of block into all enumeration.
@@ -101,6 +210,22 @@ class Block : public QObject, public Identified, public Factoriable, public Fact
          * @return state
          */
         bool validInputs() const;
+        /**
+         * Returns values of all input ports.
+         * @return values in order of ports
+         */
+        QVector<Value> inputValues() const;
+
+        /**
+         * Has block breakpoint for debugging?
+         * @return state
+         */
+        bool breakpoint() const;
+        /**
+         * Sets breakpoint for debugging.
+         * @param v state
+         */
+        void setBreakpoint(bool v);
 
     signals:
         /**
@@ -108,6 +233,22 @@ class Block : public QObject, public Identified, public Factoriable, public Fact
          * @param blockId block to delete
          */
         void deleteRequest(Identifier blockId);
+        /**
+         * Request for deleting several blocks and joins at once.
+         * @param blockIds blocks to delete
+         * @param joinIds joins to delete
+         */
+        void deleteItemsRequest(const QSet<Identifier> &blockIds, const QSet<Identifier> &joinIds);
+        /**
+         * On value of input port changed by user.
+         * @param blockId identifier of edited block
+         */
+        void inputEdited(Identifier blockId);
+        /**
+         * Request for debugging up to this block.
+         * @param blockId block identifier
+         */
+        void runToRequest(Identifier blockId);
 };
 
 
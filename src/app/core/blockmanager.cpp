@@ -9,20 +9,28 @@
 
 #include "blockmanager.h"
 #include <QJsonArray>
+#include "schemecompiler.h"
+#include <algorithm>
+
+BlockManager::BlockManager() : QObject{} {
+    m_viewRefreshTimer.setSingleShot(true);
+    m_viewRefreshTimer.setInterval(BlockManager::s_viewRefreshInterval);
+    connect(&m_viewRefreshTimer, &QTimer::timeout, this, &BlockManager::refreshViews);
+}
 
 BlockManager::~BlockManager() {
-    for (auto join: m_joins.values())
+    for (auto join: m_joins)
         delete join;
 }
 
 QJsonObject BlockManager::blockToJson(Block* block) {
     QJsonObject jsonObject;
     jsonObject["type"] = block->classId();
-    jsonObject["output_value"] = QJsonValue::fromVariant(block->outputPort()->value()["value"]);
+    jsonObject["output_value"] = QJsonValue::fromVariant(block->outputPort()->value().toVariant());
 
     QJsonArray input_values;
     for (auto port: block->inputPorts())
-        input_values.append(QJsonValue::fromVariant(port->value()["value"]));
+        input_values.append(QJsonValue::fromVariant(port->value().toVariant()));
     jsonObject["input_values"] = QJsonValue(input_values);
 
     return jsonObject;
@@ -33,12 +41,10 @@ Block* BlockManager::blockFromJson(const QJsonObject &json, QGraphicsWidget* par
     for (int i = 0; i < block->inputPorts().length(); i++) {
         auto inputPort = block->inputPorts().at(i);
         QJsonArray values = json["input_values"].toArray();
-        inputPort->setValue(MappedDataValues{{"value", values.at(i).toVariant()},});
+        inputPort->setValue(Value::fromVariant(values.at(i).toVariant()));
     }
 
-    block->outputPort()->setValue(MappedDataValues{
-            {"value", json["output_value"].toVariant()},
-    });
+    block->outputPort()->setValue(Value::fromVariant(json["output_value"].toVariant()));
     return block;
 }
 
@@ -46,30 +52,34 @@ const char* BlockManager::blockMimeType() {
     return "application/x-block-data";
 }
 
-const QMap<Identifier, Block*> &BlockManager::blocks() const {
+const SlotMap<Block*> &BlockManager::blocks() const {
     return m_blocks;
 }
 
-const QMap<Identifier, Join*> &BlockManager::joins() const {
+const SlotMap<Join*> &BlockManager::joins() const {
     return m_joins;
 }
 
+QList<Join*> BlockManager::inputJoins(Identifier blockId) const {
+    return m_inputJoins.value(blockId);
+}
+
+QList<Join*> BlockManager::outputJoins(Identifier blockId) const {
+    return m_outputJoins.value(blockId);
+}
+
 QSet<Identifier> BlockManager::blockBlocksInputs(Identifier blockId) const {
     QSet<Identifier> result;
-    for (auto join: m_joins.values()) {
-        if (join->toBlock() == blockId)
-            result.insert(join->fromBlock());
-    }
+    for (auto join: m_inputJoins.value(blockId))
+        result.insert(join->fromBlock());
 
     return result;
 }
 
 QSet<Identifier> BlockManager::blockBlocksOutputs(Identifier blockId) const {
     QSet<Identifier> result;
-    for (auto join: m_joins.values()) {
-        if (join->fromBlock() == blockId)
-            result.insert(join->toBlock());
-    }
+    for (auto join: m_outputJoins.value(blockId))
+        result.insert(join->toBlock());
 
     return result;
 }
@@ -77,20 +87,16 @@ QSet<Identifier> BlockManager::blockBlocksOutputs(Identifier blockId) const {
 
 QList<QPair<Identifier, Identifier> > BlockManager::blockInputs(Identifier blockId) const {
     QList<QPair<Identifier, Identifier> > result;
-    for (auto join: m_joins.values()) {
-        if (join->toBlock() == blockId)
-            result.append(qMakePair(join->fromBlock(), join->fromPort()));
-    }
+    for (auto join: m_inputJoins.value(blockId))
+        result.append(qMakePair(join->fromBlock(), join->fromPort()));
 
     return result;
 }
 
 QList<QPair<Identifier, Identifier> > BlockManager::blockOutputs(Identifier blockId) const {
     QList<QPair<Identifier, Identifier> > result;
-    for (auto join: m_joins.values()) {
-        if (join->fromBlock() == blockId)
-            result.append(qMakePair(join->toBlock(), join->toPort()));
-    }
+    for (auto join: m_outputJoins.value(blockId))
+        result.append(qMakePair(join->toBlock(), join->toPort()));
 
     return result;
 }
@@ -98,23 +104,50 @@ QList<QPair<Identifier, Identifier> > BlockManager::blockOutputs(Identifier bloc
 void BlockManager::addBlock(Block* block) {
     if (block == nullptr)
         return;
-    m_blocks[block->id()] = block;
+    m_blocks.insert(block->id(), block);
+    block->setCacheLimit(m_cacheLimit);
+    this->invalidatePlan();
     connect(block, &Block::deleteRequest, this, &BlockManager::deleteBlock);
+    connect(block, &Block::inputEdited, this, &BlockManager::markDirty);
+    connect(block, &Block::runToRequest, this, &BlockManager::runToRequest);
+    connect(block, &Block::deleteItemsRequest, this, &BlockManager::deleteItems);
+}
+
+void BlockManager::unlinkJoin(Join* join) {
+    QList<Join*> &outputs = m_outputJoins[join->fromBlock()];
+    outputs.removeOne(join);
+    if (outputs.isEmpty())
+        m_outputJoins.remove(join->fromBlock());
+
+    QList<Join*> &inputs = m_inputJoins[join->toBlock()];
+    inputs.removeOne(join);
+    if (inputs.isEmpty())
+        m_inputJoins.remove(join->toBlock());
 }
 
 void BlockManager::addJoin(Join* join) {
     if (join == nullptr)
         return;
-    m_joins[join->id()] = join;
+    m_joins.insert(join->id(), join);
+    m_outputJoins[join->fromBlock()].append(join);
+    m_inputJoins[join->toBlock()].append(join);
+    this->invalidatePlan();
 
-    Block* fromBlock = m_blocks[join->fromBlock()];
-    Block* toBlock = m_blocks[join->toBlock()];
+    Block* fromBlock = m_blocks.value(join->fromBlock());
+    Block* toBlock = m_blocks.value(join->toBlock());
+    BlockPort* toPort = toBlock->inputPorts().at(join->toPort());
 
-    fromBlock->outputPort()->view()->animateHide();
-    toBlock->inputPorts().at(join->toPort())->view()->animateHide();
-    join->view()->adjustJoin();
+    fromBlock->outputPort()->addConnection();
+    toPort->addConnection();
+    toPort->setSource(fromBlock->outputPort());
 
     connect(join, &Join::deleteRequest, [this](Identifier id) { this->deleteJoin(id); });
+    if (join->view() == nullptr || fromBlock->view() == nullptr || toBlock->view() == nullptr)
+        return;
+
+    fromBlock->outputPort()->view()->animateHide();
+    toPort->view()->animateHide();
+    join->view()->adjustJoin();
     connect(fromBlock->view(), &BlockView::geometryChanged, join->view(), &JoinView::adjustJoin);
     connect(toBlock->view(), &BlockView::geometryChanged, join->view(), &JoinView::adjustJoin);
 }
@@ -132,17 +165,18 @@ void BlockManager::deleteBlock(Identifier id) {
         return;
 
     QList<Identifier> joinIdsToDelete;
-
-    for (auto join: m_joins.values()) {
-        if (join->fromBlock() == b->id() || join->toBlock() == b->id())
+    for (auto join: m_inputJoins.value(id) + m_outputJoins.value(id)) {
+        if (!joinIdsToDelete.contains(join->id()))
             joinIdsToDelete.append(join->id());
     }
 
     for (int i = 0; i < joinIdsToDelete.length(); i++)
         this->deleteJoin(joinIdsToDelete.at(i), id);
-    joinIdsToDelete.clear();
 
     m_blocks.remove(id);
+    m_dirtyBlocks.remove(id);
+    m_pendingViews.remove(id);
+    this->invalidatePlan();
     b->deleteLater();
 
     emit this->blockDeleted();
@@ -157,17 +191,87 @@ void BlockManager::deleteJoin(Identifier id, Identifier excludeBlockId) {
     if (j == nullptr)
         return;
 
-    if (j->fromBlock() != excludeBlockId)
-        m_blocks[j->fromBlock()]->outputPort()->view()->animateShow();
-    if (j->toBlock() != excludeBlockId)
-        m_blocks[j->toBlock()]->inputPorts().at(j->toPort())->view()->animateShow();
+    BlockPort* fromPort = m_blocks.value(j->fromBlock())->outputPort();
+    BlockPort* toPort = m_blocks.value(j->toBlock())->inputPorts().at(j->toPort());
+    fromPort->removeConnection();
+    toPort->removeConnection();
+    toPort->setSource(nullptr);
+
+    if (j->fromBlock() != excludeBlockId && !fromPort->isConnected() && fromPort->view() != nullptr)
+        fromPort->view()->animateShow();
+    if (j->toBlock() != excludeBlockId && !toPort->isConnected() && toPort->view() != nullptr)
+        toPort->view()->animateShow();
 
     m_joins.remove(id);
+    this->unlinkJoin(j);
+    this->invalidatePlan();
     j->deleteLater();
 
     emit this->joinDeleted();
 }
 
+void BlockManager::deleteItems(const QSet<Identifier> &blockIds, const QSet<Identifier> &joinIds) {
+    if (m_disableDelete)
+        return;
+
+    QSet<Join*> joins;
+    for (Identifier id: joinIds) {
+        Join* join = m_joins.value(id, nullptr);
+        if (join != nullptr)
+            joins.insert(join);
+    }
+    for (Identifier id: blockIds) {
+        for (auto join: m_inputJoins.value(id))
+            joins.insert(join);
+        for (auto join: m_outputJoins.value(id))
+            joins.insert(join);
+    }
+
+    for (auto join: joins) {
+        // ports of deleted blocks are not touched, they are destroyed with their block
+        if (!blockIds.contains(join->fromBlock())) {
+            BlockPort* fromPort = m_blocks.value(join->fromBlock())->outputPort();
+            fromPort->removeConnection();
+            if (!fromPort->isConnected() && fromPort->view() != nullptr)
+                fromPort->view()->animateShow();
+        }
+        if (!blockIds.contains(join->toBlock())) {
+            BlockPort* toPort = m_blocks.value(join->toBlock())->inputPorts().at(join->toPort());
+            toPort->removeConnection();
+            toPort->setSource(nullptr);
+            if (!toPort->isConnected() && toPort->view() != nullptr)
+                toPort->view()->animateShow();
+        }
+
+        m_joins.remove(join->id());
+        this->unlinkJoin(join);
+        join->deleteLater();
+    }
+
+    int deletedBlocks = 0;
+    for (Identifier id: blockIds) {
+        Block* block = m_blocks.take(id);
+        if (block == nullptr)
+            continue;
+        m_dirtyBlocks.remove(id);
+        m_pendingViews.remove(id);
+        block->deleteLater();
+        deletedBlocks++;
+    }
+
+    if (deletedBlocks == 0 && joins.isEmpty())
+        return;
+    this->invalidatePlan();
+    if (deletedBlocks > 0)
+        emit this->blockDeleted();
+    else
+        emit this->joinDeleted();
+}
+
+void BlockManager::clear() {
+    this->deleteItems(m_blocks.keys().toSet(), QSet<Identifier>{});
+}
+
 void BlockManager::setDisableDelete(bool v) {
     m_disableDelete = v;
 }
@@ -176,3 +280,164 @@ Block* BlockManager::block(Identifier id) const {
     return m_blocks.value(id, nullptr);
 }
 
+Block* BlockManager::block(const SlotMap<Block*>::Handle &handle) const {
+    return m_blocks.value(handle, nullptr);
+}
+
+SlotMap<Block*>::Handle BlockManager::blockHandle(Identifier id) const {
+    return m_blocks.handle(id);
+}
+
+void BlockManager::invalidatePlan() {
+    m_planDirty = true;
+    m_programDirty = true;
+    m_resultsValid = false;
+    m_revision++;
+}
+
+const EvaluationPlan &BlockManager::plan() const {
+    if (m_planDirty) {
+        m_plan.build(this);
+        m_planDirty = false;
+    }
+    return m_plan;
+}
+
+SchemeProgram* BlockManager::program() {
+    if (m_programDirty) {
+        m_program = SchemeProgram{};
+        m_programValid = SchemeCompiler::compile(this, &m_program);
+        m_programDirty = false;
+    }
+    return m_programValid ? &m_program : nullptr;
+}
+
+bool BlockManager::resultsValid() const {
+    return m_resultsValid;
+}
+
+QList<Identifier> BlockManager::dirtyOrder() const {
+    QSet<Identifier> cone;
+    QList<Identifier> toExpand = m_dirtyBlocks.toList();
+    while (!toExpand.isEmpty()) {
+        const Identifier blockId = toExpand.takeLast();
+        if (cone.contains(blockId))
+            continue;
+        cone.insert(blockId);
+        for (auto output: this->blockOutputs(blockId))
+            toExpand.append(output.first);
+    }
+
+    const EvaluationPlan &plan = this->plan();
+    QList<Identifier> order = cone.toList();
+    std::sort(order.begin(), order.end(), [&plan](Identifier a, Identifier b) {
+        return plan.position(a) < plan.position(b);
+    });
+    return order;
+}
+
+void BlockManager::setEvaluated() {
+    m_dirtyBlocks.clear();
+    m_resultsValid = true;
+}
+
+void BlockManager::invalidateResults() {
+    m_resultsValid = false;
+}
+
+quint64 BlockManager::revision() const {
+    return m_revision;
+}
+
+void BlockManager::setProfiling(bool v) {
+    Block::setProfiling(v);
+    for (auto block: m_blocks)
+        block->resetProfile();
+}
+
+QList<Identifier> BlockManager::profileOrder(BlockProfile::Key key) const {
+    const auto cost = [key](const BlockProfile &profile) -> quint64 {
+        if (key == BlockProfile::Calls)
+            return profile.calls;
+        else if (key == BlockProfile::Allocations)
+            return profile.allocations;
+        return static_cast<quint64>(profile.nanoseconds);
+    };
+
+    // equal costs keep order of identifiers
+    QList<Identifier> order = m_blocks.keys();
+    std::sort(order.begin(), order.end());
+    std::stable_sort(order.begin(), order.end(), [this, &cost](Identifier a, Identifier b) {
+        return cost(m_blocks.value(a)->profile()) > cost(m_blocks.value(b)->profile());
+    });
+    return order;
+}
+
+QString BlockManager::profileReport(BlockProfile::Key key) const {
+    QString report = QString("%1 %2 %3 %4\n")
+            .arg("block", -24).arg("time [us]", 12).arg("calls", 10).arg("allocations", 12);
+    for (Identifier blockId: this->profileOrder(key)) {
+        const Block* block = m_blocks.value(blockId);
+        const BlockProfile &profile = block->profile();
+        report += QString("%1 %2 %3 %4\n")
+                .arg(QString("%1#%2").arg(block->classId()).arg(blockId), -24)
+                .arg(profile.nanoseconds / 1000., 12, 'f', 1)
+                .arg(profile.calls, 10)
+                .arg(profile.allocations, 12);
+    }
+    return report;
+}
+
+void BlockManager::setCacheLimit(int entries) {
+    m_cacheLimit = entries;
+    for (auto block: m_blocks)
+        block->setCacheLimit(entries);
+}
+
+quint64 BlockManager::cacheHits() const {
+    quint64 hits = 0;
+    for (auto block: m_blocks)
+        hits += block->cacheHits();
+    return hits;
+}
+
+quint64 BlockManager::cacheMisses() const {
+    quint64 misses = 0;
+    for (auto block: m_blocks)
+        misses += block->cacheMisses();
+    return misses;
+}
+
+void BlockManager::markDirty(Identifier id) {
+    if (!m_blocks.contains(id))
+        return;
+    m_dirtyBlocks.insert(id);
+    m_revision++;
+    emit this->blockDirty(id);
+}
+
+void BlockManager::evaluateBlock(Identifier blockId) {
+    Block* block = m_blocks.value(blockId, nullptr);
+    if (block == nullptr)
+        return;
+
+    this->publishResult(blockId, block->cachedEvaluate(block->inputValues()));
+}
+
+void BlockManager::publishResult(Identifier blockId, const Value &result) {
+    // joined input ports share value of output port, their views are hidden while connected
+    m_blocks.value(blockId)->outputPort()->setValueFromView(result);
+    m_pendingViews.insert(blockId);
+    if (!m_viewRefreshTimer.isActive())
+        m_viewRefreshTimer.start();
+}
+
+void BlockManager::refreshViews() {
+    for (Identifier blockId: m_pendingViews) {
+        Block* block = m_blocks.value(blockId, nullptr);
+        if (block != nullptr && block->outputPort()->view() != nullptr)
+            block->outputPort()->view()->invalidateValue();
+    }
+    m_pendingViews.clear();
+}
+
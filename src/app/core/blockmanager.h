@@ -11,9 +11,13 @@
 #define BLOCKMANAGER_H
 
 #include <QJsonObject>
-#include <QMap>
+#include <QHash>
+#include <QTimer>
 #include "block.h"
 #include "join.h"
+#include "evaluationplan.h"
+#include "schemeprogram.h"
+#include "slotmap.h"
 
 
 /**
@@ -26,18 +30,85 @@ class BlockManager : public QObject {
         /**
          * All blocks mapped to ids.
          */
-        QMap<Identifier, Block*> m_blocks;
+        SlotMap<Block*> m_blocks;
         /**
          * All joins mapped to ids.
          */
-        QMap<Identifier, Join*> m_joins;
+        SlotMap<Join*> m_joins;
+        /**
+         * Joins ending in block, for every block with any.
+         */
+        QHash<Identifier, QList<Join*> > m_inputJoins;
+        /**
+         * Joins starting in block, for every block with any.
+         */
+        QHash<Identifier, QList<Join*> > m_outputJoins;
         /**
          * Is deleting disabled?
          */
         bool m_disableDelete = false;
+        /**
+         * Cached plan of evaluation.
+         */
+        mutable EvaluationPlan m_plan;
+        /**
+         * Has topology changed since last plan build?
+         */
+        mutable bool m_planDirty = true;
+        /**
+         * Cached compiled scheme.
+         */
+        SchemeProgram m_program;
+        /**
+         * Has topology changed since last compilation? Literal values are reloaded on each run.
+         */
+        bool m_programDirty = true;
+        /**
+         * Was last compilation successful?
+         */
+        bool m_programValid = false;
+        /**
+         * Blocks with inputs edited since last evaluation.
+         */
+        QSet<Identifier> m_dirtyBlocks;
+        /**
+         * Are values of all ports result of evaluation of actual scheme?
+         */
+        bool m_resultsValid = false;
+        /**
+         * Count of cached results for every block.
+         */
+        int m_cacheLimit = 0;
+        /**
+         * Counter of changes of topology or input values.
+         */
+        quint64 m_revision = 0;
+        /**
+         * Blocks with published result not yet shown in view of output port.
+         */
+        QSet<Identifier> m_pendingViews;
+        /**
+         * Timer delaying refresh of views to next frame.
+         */
+        QTimer m_viewRefreshTimer;
+
+        /**
+         * Minimal interval between refreshes of port views, one frame at 60 Hz.
+         */
+        static constexpr int s_viewRefreshInterval = 16;
+
+        /**
+         * Marks evaluation plan to be rebuilt on next request.
+         */
+        void invalidatePlan();
+        /**
+         * Removes join from adjacency lists of its blocks.
+         * @param join join
+         */
+        void unlinkJoin(Join* join);
 
     public:
-        BlockManager() : QObject{} {}
+        BlockManager();
         ~BlockManager() override;
 
         /**
@@ -63,12 +134,24 @@ class BlockManager : public QObject {
          * All blocks getter.
          * @return blocks
          */
-        const QMap<Identifier, Block*> &blocks() const;
+        const SlotMap<Block*> &blocks() const;
         /**
          * All joins getter.
          * @return joins
          */
-        const QMap<Identifier, Join*> &joins() const;
+        const SlotMap<Join*> &joins() const;
+        /**
+         * Joins ending in block.
+         * @param blockId block id
+         * @return joins
+         */
+        QList<Join*> inputJoins(Identifier blockId) const;
+        /**
+         * Joins starting in block.
+         * @param blockId block id
+         * @return joins
+         */
+        QList<Join*> outputJoins(Identifier blockId) const;
 
         /**
          * Returns all input ports for block defined by id.
@@ -112,6 +195,100 @@ class BlockManager : public QObject {
          * @return found block
          */
         Block* block(Identifier id) const;
+        /**
+         * Get block by handle, stale handle of deleted block is detected.
+         * @param handle block handle
+         * @return found block, nullptr for stale handle
+         */
+        Block* block(const SlotMap<Block*>::Handle &handle) const;
+        /**
+         * Returns handle of block for repeated lookups without hashing.
+         * @param id block identifier
+         * @return handle
+         */
+        SlotMap<Block*>::Handle blockHandle(Identifier id) const;
+
+        /**
+         * Returns evaluation plan for actual topology, rebuilds it only after structural change.
+         * @return plan
+         */
+        const EvaluationPlan &plan() const;
+        /**
+         * Returns scheme compiled for register machine, compiles it only after structural change.
+         * @return program, nullptr if scheme cannot be compiled
+         */
+        SchemeProgram* program();
+
+        /**
+         * Are results of last evaluation still valid for actual topology?
+         * @return state
+         */
+        bool resultsValid() const;
+        /**
+         * Returns dirty blocks with all their successors in order of evaluation.
+         * @return blocks identifiers
+         */
+        QList<Identifier> dirtyOrder() const;
+        /**
+         * Marks all results as actual and clears dirty blocks.
+         */
+        void setEvaluated();
+        /**
+         * Marks all results as stale, so next evaluation has to be complete.
+         */
+        void invalidateResults();
+        /**
+         * Revision of scheme, changes with every edit of topology or input values.
+         * @return revision
+         */
+        quint64 revision() const;
+
+        /**
+         * Sets count of cached results for all present and future blocks, zero disables caching.
+         * @param entries count of results per block
+         */
+        void setCacheLimit(int entries);
+        /**
+         * Count of evaluations answered from cache over all blocks.
+         * @return hits
+         */
+        quint64 cacheHits() const;
+        /**
+         * Count of evaluations missing in cache over all blocks.
+         * @return misses
+         */
+        quint64 cacheMisses() const;
+
+        /**
+         * Enables profiling of block evaluations and clears collected profiles.
+         * @param v state
+         */
+        void setProfiling(bool v);
+        /**
+         * Blocks ordered by cost, most expensive first.
+         * @param key cost to sort by
+         * @return block identifiers
+         */
+        QList<Identifier> profileOrder(BlockProfile::Key key) const;
+        /**
+         * Table of collected profiles, most expensive blocks first.
+         * @param key cost to sort by
+         * @return report
+         */
+        QString profileReport(BlockProfile::Key key) const;
+
+        /**
+         * Evaluates block from values of its ports and propagates result to connected blocks.
+         * @param blockId block identifier
+         */
+        void evaluateBlock(Identifier blockId);
+        /**
+         * Sets computed result to output port of block, joined input ports share it without copy.
+         * View of port is refreshed in next frame.
+         * @param blockId block identifier
+         * @param result computed value
+         */
+        void publishResult(Identifier blockId, const Value &result);
 
         /**
          * Get block by id from schema.
@@ -137,6 +314,28 @@ class BlockManager : public QObject {
          * @param excludeBlockId exlude block identifier
          */
         void deleteJoin(Identifier id, Identifier excludeBlockId = -1);
+        /**
+         * Deletes blocks with their joins and other joins in one pass, freed ports of remaining blocks are shown animated.
+         * Emits only one of blockDeleted or joinDeleted.
+         * @param blockIds blocks to delete
+         * @param joinIds joins to delete
+         */
+        void deleteItems(const QSet<Identifier> &blockIds, const QSet<Identifier> &joinIds);
+        /**
+         * Deletes all blocks and joins at once.
+         */
+        void clear();
+        /**
+         * Marks block for reevaluation after edit of its input.
+         * @param id block identifier
+         */
+        void markDirty(Identifier id);
+
+    private slots:
+        /**
+         * Pushes values published since last refresh to shown port views.
+         */
+        void refreshViews();
 
     signals:
         /**
@@ -147,6 +346,16 @@ class BlockManager : public QObject {
          * On join deleted signal.
          */
         void joinDeleted();
+        /**
+         * On block marked as dirty.
+         * @param id block identifier
+         */
+        void blockDirty(Identifier id);
+        /**
+         * On request for debugging up to block.
+         * @param id block identifier
+         */
+        void runToRequest(Identifier id);
 };
 
 
@@ -0,0 +1,63 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#include "blockprofile.h"
+
+#include <cstdlib>
+#include <new>
+#include "block.h"
+
+#ifdef BLOCK_PROFILE_ALLOCATIONS
+namespace {
+    thread_local quint64 t_allocations = 0;
+}
+
+// every heap allocation of application is counted per thread, so evaluation of block can be attributed
+void* operator new(std::size_t size) {
+    t_allocations++;
+    if (size == 0)
+        size = 1;
+    void* memory;
+    while ((memory = std::malloc(size)) == nullptr) {
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr)
+            throw std::bad_alloc();
+        handler();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+quint64 BlockProfile::threadAllocations() {
+    return t_allocations;
+}
+#else
+quint64 BlockProfile::threadAllocations() {
+    return 0;
+}
+#endif
+
+ProfileScope::ProfileScope(Block* block) : m_block{Block::profiling() ? block : nullptr} {
+    if (m_block == nullptr)
+        return;
+    m_allocations = BlockProfile::threadAllocations();
+    m_timer.start();
+}
+
+ProfileScope::~ProfileScope() {
+    if (m_block != nullptr)
+        m_block->recordProfile(m_timer.nsecsElapsed(), BlockProfile::threadAllocations() - m_allocations);
+}
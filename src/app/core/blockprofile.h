@@ -0,0 +1,62 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#ifndef BLOCKPROFILE_H
+#define BLOCKPROFILE_H
+
+#include <QElapsedTimer>
+#include <QtGlobal>
+
+class Block;
+
+/**
+ * Cost of evaluations of one block.
+ */
+struct BlockProfile {
+    /**
+     * Keys for sorting of profiles.
+     */
+    enum Key {
+        Time,
+        Calls,
+        Allocations
+    };
+
+    qint64 nanoseconds = 0;
+    quint64 calls = 0;
+    quint64 allocations = 0;
+
+    /**
+     * Count of heap allocations made by calling thread since its start.
+     * Counted only in build with BLOCK_PROFILE_ALLOCATIONS, which replaces global operator new.
+     * @return allocations, always zero in other builds
+     */
+    static quint64 threadAllocations();
+};
+
+/**
+ * Measures time and allocations from construction to destruction and adds them to profile of block.
+ * Does nothing if profiling is disabled.
+ */
+class ProfileScope {
+    private:
+        Block* m_block;
+        QElapsedTimer m_timer;
+        quint64 m_allocations = 0;
+
+    public:
+        /**
+         * Starts measurement.
+         * @param block measured block
+         */
+        explicit ProfileScope(Block* block);
+        ~ProfileScope();
+};
+
+#endif // BLOCKPROFILE_H
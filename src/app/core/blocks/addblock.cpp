@@ -8,24 +8,35 @@
  */
 
 #include "addblock.h"
+#include <algorithm>
+#include <app/core/vectorkernels.h>
 
 AddBlock::AddBlock(QGraphicsWidget* parent) : Block(parent) {
     BlockView* blockView = this->view();
-    blockView->setSvgImage(":/res/image/add_symbol.svg");
+    if (blockView != nullptr)
+        blockView->setSvgImage(":/res/image/add_symbol.svg");
     this->setInputPorts({new BlockPortValue(this->id(), Type::Scalar, blockView),
                          new BlockPortValue(this->id(), Type::Scalar, blockView)});
     this->setOutputPort(new BlockPortValue(this->id(), Type::Scalar, blockView));
 
-    blockView->initPortsViews();
+    if (blockView != nullptr)
+        blockView->initPortsViews();
 }
 
-MappedDataValues AddBlock::evaluate(const QList<MappedDataValues> &inputData) {
+Value AddBlock::evaluate(const QVector<Value> &inputData) {
     Q_ASSERT(this->inputMatchesPorts(inputData));
 
     double result = 0;
 
-    for (const MappedDataValues &port: inputData)
-        result += port["value"].toDouble();
-    return {{"value", QVariant(result)}};
+    for (const Value &port: inputData)
+        result += port.toDouble();
+    return Value{result};
 }
 
+void AddBlock::evaluateColumns(const QList<const DataColumn*> &inputs, DataColumn &output, int rows) {
+    output.reset(1, rows);
+    double* result = output.data();
+    std::fill(result, result + rows, 0.);
+    for (const DataColumn* column: inputs)
+        VectorKernels::add(result, column->data(), result, rows);
+}
@@ -31,7 +31,14 @@ class AddBlock : public Block {
          * @param inputData input data
          * @return computed data
          */
-        MappedDataValues evaluate(const QList<MappedDataValues> &inputData) override;
+        Value evaluate(const QVector<Value> &inputData) override;
+        /**
+         * Evaluate add operation on columns of input data.
+         * @param inputs input columns
+         * @param output result column
+         * @param rows count of rows
+         */
+        void evaluateColumns(const QList<const DataColumn*> &inputs, DataColumn &output, int rows) override;
 };
 
 #endif // ADDBLOCK_H
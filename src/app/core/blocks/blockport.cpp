@@ -9,6 +9,8 @@
 
 #include "blockport.h"
 
+#include <QRegularExpression>
+
 void BlockPort::setView(BlockPortView* v) {
     m_view = v;
 }
@@ -17,14 +19,29 @@ BlockPort::BlockPort(Identifier blockId, Type::TypeE type) {
     m_type = type;
     m_view = nullptr;
     m_blockId = blockId;
+    m_value = Type::defaultData(type);
 }
 
 BlockPort::~BlockPort() {
-    m_view->deleteLater();
+    if (m_view != nullptr)
+        m_view->deleteLater();
+}
+
+const Value &BlockPort::value() const {
+    if (m_source != nullptr)
+        return m_source->value();
+    return m_value;
 }
 
-MappedDataValues BlockPort::value() const {
-    return m_view->value();
+void BlockPort::setValue(const Value &v) {
+    this->setValueFromView(v);
+    if (m_view != nullptr)
+        m_view->setValue(m_value);
+}
+
+void BlockPort::setValueFromView(const Value &v) {
+    m_valid = v.isValid();
+    m_value = v;
 }
 
 void BlockPort::setIsOutput(bool v) {
@@ -48,11 +65,36 @@ Type::TypeE BlockPort::type() const {
 }
 
 bool BlockPort::valid() const {
-    return m_view->valid();
+    if (m_source != nullptr)
+        return m_source->valid();
+    return m_valid;
 }
 
 bool BlockPort::isConnected() const {
-    return m_view->opacity() == 0.;
+    return m_connections > 0;
+}
+
+void BlockPort::addConnection() {
+    m_connections++;
+}
+
+void BlockPort::removeConnection() {
+    if (m_connections > 0)
+        m_connections--;
+}
+
+void BlockPort::setSource(const BlockPort* source) {
+    if (source == nullptr && m_source != nullptr) {
+        const Value last = m_source->value();
+        m_source = nullptr;
+        this->setValue(last);
+        return;
+    }
+    m_source = source;
+}
+
+const BlockPort* BlockPort::source() const {
+    return m_source;
 }
 
 QString Type::toString(Type::TypeE type) {
@@ -90,3 +132,49 @@ QString Type::defaultValue(Type::TypeE type) {
         return "{0, 0}";
     return "";
 }
+
+Value Type::defaultData(Type::TypeE type) {
+    if (type == Type::Scalar || type == Type::Angle)
+        return Value{0.};
+    else if (type == Type::Vector)
+        return Value::vector(2);
+    return Value{};
+}
+
+Value Type::parse(Type::TypeE type, const QString &str) {
+    static const QRegularExpression scalarValidator{Type::validator(Type::Scalar)};
+    static const QRegularExpression vectorValidator{Type::validator(Type::Vector)};
+
+    if (type == Type::Scalar || type == Type::Angle) {
+        if (!scalarValidator.match(str).hasMatch())
+            return Value{};
+        return Value{str.toDouble()};
+    } else if (type == Type::Vector) {
+        if (!vectorValidator.match(str).hasMatch())
+            return Value{};
+        QString raw = str;
+        raw = raw.remove("{").remove("}");
+        const QStringList items = raw.split(",");
+        Value value = Value::vector(items.length());
+        for (int i = 0; i < items.length(); i++)
+            value.data()[i] = items.at(i).toDouble();
+
+        return value;
+    }
+    return Value{};
+}
+
+QString Type::format(const Value &value, int precision) {
+    if (!value.isValid())
+        return "";
+    else if (!value.isVector())
+        return QString::number(value.toDouble(), 'g', precision);
+
+    QString repr = "{";
+    for (int i = 0; i < value.length(); i++) {
+        repr += QString::number(value.data()[i], 'g', precision);
+        if (i + 1 < value.length())
+            repr += ",";
+    }
+    return repr + "}";
+}
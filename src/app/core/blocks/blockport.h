@@ -53,6 +53,26 @@ class Type {
          * @return default value as string
          */
         static QString defaultValue(TypeE type);
+        /**
+         * Returns default value for type as data.
+         * @param type type
+         * @return default value
+         */
+        static Value defaultData(TypeE type);
+        /**
+         * Parses string representation of value for type.
+         * @param type type of value
+         * @param str string to parse
+         * @return parsed value, invalid if string is not valid for type
+         */
+        static Value parse(TypeE type, const QString &str);
+        /**
+         * Converts value into string representation.
+         * @param value value to convert
+         * @param precision count of significant digits, 17 keeps doubles exact
+         * @return string resp.
+         */
+        static QString format(const Value &value, int precision = 6);
 };
 
 /**
@@ -64,6 +84,10 @@ class BlockPort {
         Identifier m_blockId;
         bool m_isOutput = false;
         Type::TypeE m_type;
+        Value m_value;
+        bool m_valid = true;
+        int m_connections = 0;
+        const BlockPort* m_source = nullptr;
 
     protected:
         /**
@@ -82,16 +106,21 @@ class BlockPort {
          */
         virtual QStringList labels() const = 0;
         /**
-         * Returns value of port
+         * Returns value of port, value of source port for connected input.
          * @return value of port
          */
-        MappedDataValues value() const;
+        const Value &value() const;
 
         /**
-         * Sets new value for port.
+         * Sets new value for port and notifies view, if any.
          * @param v new value
          */
-        virtual void setValue(MappedDataValues v) = 0;
+        virtual void setValue(const Value &v);
+        /**
+         * Sets new value without notifying view, e.g. value edited by user in view.
+         * @param v new value, invalid for invalid input
+         */
+        void setValueFromView(const Value &v);
         /**
          * Sets flag if is port as output.
          * @param v state
@@ -128,6 +157,25 @@ class BlockPort {
          * @return state
          */
         bool isConnected() const;
+        /**
+         * Registers new join connected to port.
+         */
+        void addConnection();
+        /**
+         * Unregisters join connected to port.
+         */
+        void removeConnection();
+        /**
+         * Makes input port share value of output port it is joined to, so results are not copied downstream.
+         * On disconnect, last shared value is kept and shown in view.
+         * @param source output port, nullptr to disconnect
+         */
+        void setSource(const BlockPort* source);
+        /**
+         * Output port which value is shared.
+         * @return port, nullptr for unconnected port
+         */
+        const BlockPort* source() const;
 };
 
 #endif // BLOCKPORT_H
@@ -27,11 +27,6 @@ class BlockPortValue : public BlockPort {
          * @return list of labels
          */
         QStringList labels() const override;
-        /**
-         * Set new value for port.
-         * @param v new value for port
-         */
-        void setValue(MappedDataValues v) override;
         /**
          * Is port output?
          * @param v state
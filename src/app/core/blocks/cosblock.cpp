@@ -12,15 +12,25 @@
 
 CosBlock::CosBlock(QGraphicsWidget* parent) : Block(parent) {
     BlockView* blockView = this->view();
-    blockView->setSvgImage(":/res/image/cos_symbol.svg");
+    if (blockView != nullptr)
+        blockView->setSvgImage(":/res/image/cos_symbol.svg");
     this->setInputPorts({new BlockPortValue(this->id(), Type::Angle, blockView),});
     this->setOutputPort(new BlockPortValue(this->id(), Type::Scalar, blockView));
 
-    blockView->initPortsViews();
+    if (blockView != nullptr)
+        blockView->initPortsViews();
 }
 
-MappedDataValues CosBlock::evaluate(const QList<MappedDataValues> &inputData) {
+Value CosBlock::evaluate(const QVector<Value> &inputData) {
     Q_ASSERT(this->inputMatchesPorts(inputData));
 
-    return {{"value", QVariant(qCos(inputData.at(0)["value"].toDouble()))}};
+    return Value{qCos(inputData.at(0).toDouble())};
+}
+
+void CosBlock::evaluateColumns(const QList<const DataColumn*> &inputs, DataColumn &output, int rows) {
+    output.reset(1, rows);
+    double* result = output.data();
+    const double* values = inputs.at(0)->data();
+    for (int row = 0; row < rows; row++)
+        result[row] = qCos(values[row]);
 }
@@ -27,7 +27,14 @@ class CosBlock : public Block {
          * @param inputData data to eval
          * @return new data
          */
-        MappedDataValues evaluate(const QList<MappedDataValues> &inputData) override;
+        Value evaluate(const QVector<Value> &inputData) override;
+        /**
+         * Evaluate cosinus operation on columns of input data.
+         * @param inputs input columns
+         * @param output result column
+         * @param rows count of rows
+         */
+        void evaluateColumns(const QList<const DataColumn*> &inputs, DataColumn &output, int rows) override;
 };
 
 #endif // COSBLOCK_H
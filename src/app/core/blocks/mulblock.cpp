@@ -8,22 +8,34 @@
  */
 
 #include "mulblock.h"
+#include <algorithm>
+#include <app/core/vectorkernels.h>
 
 MulBlock::MulBlock(QGraphicsWidget* parent) : Block(parent) {
     BlockView* blockView = this->view();
-    blockView->setSvgImage(":/res/image/mul_symbol.svg");
+    if (blockView != nullptr)
+        blockView->setSvgImage(":/res/image/mul_symbol.svg");
     this->setInputPorts({new BlockPortValue(this->id(), Type::Scalar, blockView),
                          new BlockPortValue(this->id(), Type::Scalar, blockView)});
     this->setOutputPort(new BlockPortValue(this->id(), Type::Scalar, blockView));
 
-    blockView->initPortsViews();
+    if (blockView != nullptr)
+        blockView->initPortsViews();
 }
 
-MappedDataValues MulBlock::evaluate(const QList<MappedDataValues> &inputData) {
+Value MulBlock::evaluate(const QVector<Value> &inputData) {
     Q_ASSERT(this->inputMatchesPorts(inputData));
 
     double result = 1;
-    for (const MappedDataValues &port: inputData)
-        result *= port["value"].toDouble();
-    return {{"value", QVariant(result)}};
+    for (const Value &port: inputData)
+        result *= port.toDouble();
+    return Value{result};
+}
+
+void MulBlock::evaluateColumns(const QList<const DataColumn*> &inputs, DataColumn &output, int rows) {
+    output.reset(1, rows);
+    double* result = output.data();
+    std::fill(result, result + rows, 1.);
+    for (const DataColumn* column: inputs)
+        VectorKernels::mul(result, column->data(), result, rows);
 }
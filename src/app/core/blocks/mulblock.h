@@ -27,7 +27,14 @@ class MulBlock : public Block {
          * @param inputData data to compute
          * @return result
          */
-        MappedDataValues evaluate(const QList<MappedDataValues> &inputData) override;
+        Value evaluate(const QVector<Value> &inputData) override;
+        /**
+         * Evaluate multiplying operation on columns of input data.
+         * @param inputs input columns
+         * @param output result column
+         * @param rows count of rows
+         */
+        void evaluateColumns(const QList<const DataColumn*> &inputs, DataColumn &output, int rows) override;
 };
 
 #endif // MULBLOCK_H
@@ -12,15 +12,25 @@
 
 SinBlock::SinBlock(QGraphicsWidget* parent) : Block(parent) {
     BlockView* blockView = this->view();
-    blockView->setSvgImage(":/res/image/sin_symbol.svg");
+    if (blockView != nullptr)
+        blockView->setSvgImage(":/res/image/sin_symbol.svg");
     this->setInputPorts({new BlockPortValue(this->id(), Type::Angle, blockView),});
     this->setOutputPort(new BlockPortValue(this->id(), Type::Scalar, blockView));
 
-    blockView->initPortsViews();
+    if (blockView != nullptr)
+        blockView->initPortsViews();
 }
 
-MappedDataValues SinBlock::evaluate(const QList<MappedDataValues> &inputData) {
+Value SinBlock::evaluate(const QVector<Value> &inputData) {
     Q_ASSERT(this->inputMatchesPorts(inputData));
 
-    return {{"value", QVariant(qSin(inputData.at(0)["value"].toDouble()))}};
+    return Value{qSin(inputData.at(0).toDouble())};
+}
+
+void SinBlock::evaluateColumns(const QList<const DataColumn*> &inputs, DataColumn &output, int rows) {
+    output.reset(1, rows);
+    double* result = output.data();
+    const double* values = inputs.at(0)->data();
+    for (int row = 0; row < rows; row++)
+        result[row] = qSin(values[row]);
 }
@@ -8,23 +8,35 @@
  */
 
 #include "subblock.h"
+#include <algorithm>
+#include <app/core/vectorkernels.h>
 
 SubBlock::SubBlock(QGraphicsWidget* parent) : Block(parent) {
     BlockView* blockView = this->view();
-    blockView->setSvgImage(":/res/image/sub_symbol.svg");
+    if (blockView != nullptr)
+        blockView->setSvgImage(":/res/image/sub_symbol.svg");
     this->setInputPorts({new BlockPortValue(this->id(), Type::Scalar, blockView),
                          new BlockPortValue(this->id(), Type::Scalar, blockView)});
     this->setOutputPort(new BlockPortValue(this->id(), Type::Scalar, blockView));
 
-    blockView->initPortsViews();
+    if (blockView != nullptr)
+        blockView->initPortsViews();
 }
 
-MappedDataValues SubBlock::evaluate(const QList<MappedDataValues> &inputData) {
+Value SubBlock::evaluate(const QVector<Value> &inputData) {
     Q_ASSERT(this->inputMatchesPorts(inputData));
 
-    double result = inputData.at(0)["value"].toDouble();
+    double result = inputData.at(0).toDouble();
 
     for (int i = 1; i < inputData.length(); i++)
-        result -= inputData.at(i)["value"].toDouble();
-    return {{"value", QVariant(result)}};
+        result -= inputData.at(i).toDouble();
+    return Value{result};
+}
+
+void SubBlock::evaluateColumns(const QList<const DataColumn*> &inputs, DataColumn &output, int rows) {
+    output.reset(1, rows);
+    double* result = output.data();
+    std::copy(inputs.at(0)->data(), inputs.at(0)->data() + rows, result);
+    for (int i = 1; i < inputs.length(); i++)
+        VectorKernels::sub(result, inputs.at(i)->data(), result, rows);
 }
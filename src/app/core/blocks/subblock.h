@@ -27,7 +27,14 @@ class SubBlock : public Block {
          * @param inputData input data
          * @return new value
          */
-        MappedDataValues evaluate(const QList<MappedDataValues> &inputData) override;
+        Value evaluate(const QVector<Value> &inputData) override;
+        /**
+         * Evaluate substracting operation on columns of input data.
+         * @param inputs input columns
+         * @param output result column
+         * @param rows count of rows
+         */
+        void evaluateColumns(const QList<const DataColumn*> &inputs, DataColumn &output, int rows) override;
 };
 
 #endif // SUBBLOCK_H
@@ -11,23 +11,35 @@
 
 VectInitBlock::VectInitBlock(QGraphicsWidget* parent) : Block(parent) {
     BlockView* blockView = this->view();
-    blockView->setSvgImage(":/res/image/vectoriaze_symbol.svg");
+    if (blockView != nullptr)
+        blockView->setSvgImage(":/res/image/vectoriaze_symbol.svg");
     this->setInputPorts({
                                 new BlockPortValue(this->id(), Type::Scalar, blockView),
                                 new BlockPortValue(this->id(), Type::Scalar, blockView),
                         });
     this->setOutputPort(new BlockPortValue(this->id(), Type::Vector, blockView));
 
-    blockView->initPortsViews();
+    if (blockView != nullptr)
+        blockView->initPortsViews();
 }
 
-MappedDataValues VectInitBlock::evaluate(const QList<MappedDataValues> &inputData) {
+Value VectInitBlock::evaluate(const QVector<Value> &inputData) {
     Q_ASSERT(this->inputMatchesPorts(inputData));
 
-    QList<QVariant> result;
+    Value result = Value::vector(inputData.length());
+    double* items = result.data();
+    for (int i = 0; i < inputData.length(); i++)
+        items[i] = inputData.at(i).toDouble();
+    return result;
+}
 
-    for (auto port: inputData) {
-        result.push_back(port["value"].toDouble());
+void VectInitBlock::evaluateColumns(const QList<const DataColumn*> &inputs, DataColumn &output, int rows) {
+    const int width = inputs.length();
+    output.reset(width, rows);
+    double* result = output.data();
+    for (int i = 0; i < width; i++) {
+        const double* values = inputs.at(i)->data();
+        for (int row = 0; row < rows; row++)
+            result[row * width + i] = values[row];
     }
-    return {{"value", QVariant(result)}};
 }
@@ -8,26 +8,31 @@
  */
 
 #include "vectmagblock.h"
-#include <QtMath>
+#include <app/core/vectorkernels.h>
 
 VectMagBlock::VectMagBlock(QGraphicsWidget* parent) : Block(parent) {
     BlockView* blockView = this->view();
-    blockView->setSvgImage(":/res/image/vect_mag_symbol.svg");
+    if (blockView != nullptr)
+        blockView->setSvgImage(":/res/image/vect_mag_symbol.svg");
     this->setInputPorts({new BlockPortValue(this->id(), Type::Vector, blockView)});
     this->setOutputPort(new BlockPortValue(this->id(), Type::Scalar, blockView));
 
-    blockView->initPortsViews();
+    if (blockView != nullptr)
+        blockView->initPortsViews();
 }
 
-MappedDataValues VectMagBlock::evaluate(const QList<MappedDataValues> &inputData) {
+Value VectMagBlock::evaluate(const QVector<Value> &inputData) {
     Q_ASSERT(this->inputMatchesPorts(inputData));
 
-    double result = 0;
+    const Value &vector = inputData.at(0);
+    return Value{VectorKernels::magnitude(vector.data(), vector.length())};
+}
 
-    for (auto port: inputData) {
-        QList<QVariant> inputVect = port["value"].toList();
-        for (auto val: inputVect)
-            result += qPow(val.toDouble(), 2);
-    }
-    return {{"value", QVariant(qSqrt(result))}};
+void VectMagBlock::evaluateColumns(const QList<const DataColumn*> &inputs, DataColumn &output, int rows) {
+    output.reset(1, rows);
+    double* result = output.data();
+    const int width = inputs.at(0)->width();
+    const double* values = inputs.at(0)->data();
+    for (int row = 0; row < rows; row++)
+        result[row] = VectorKernels::magnitude(values + row * width, width);
 }
@@ -0,0 +1,82 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#include "blockscheduler.h"
+
+#include <QHash>
+#include <QVector>
+#include <algorithm>
+#include "blockmanager.h"
+
+BlockScheduler::BlockScheduler(const BlockManager* manager) : m_manager{manager} {}
+
+void BlockScheduler::schedule() {
+    m_order.clear();
+    m_unschedulable.clear();
+    if (m_manager == nullptr)
+        return;
+
+    // storage order changes with removals, ties are broken by identifier so order depends only on scheme
+    QList<Identifier> blockIds = m_manager->blocks().keys();
+    std::sort(blockIds.begin(), blockIds.end());
+    const int count = blockIds.length();
+
+    QHash<Identifier, int> indexes;
+    indexes.reserve(count);
+    for (int i = 0; i < count; i++)
+        indexes.insert(blockIds.at(i), i);
+
+    // adjacency index over joins, one pass
+    QVector<int> inDegree(count, 0);
+    QVector<QVector<int> > successors(count);
+    for (auto join: m_manager->joins()) {
+        const int from = indexes.value(join->fromBlock(), -1);
+        const int to = indexes.value(join->toBlock(), -1);
+        if (from < 0 || to < 0)
+            continue;
+        successors[from].append(to);
+        inDegree[to]++;
+    }
+    for (auto &next: successors)
+        std::sort(next.begin(), next.end());
+
+    QVector<int> queue;
+    queue.reserve(count);
+    for (int i = 0; i < count; i++) {
+        if (inDegree.at(i) == 0)
+            queue.append(i);
+    }
+
+    m_order.reserve(count);
+    for (int head = 0; head < queue.size(); head++) {
+        const int current = queue.at(head);
+        m_order.append(blockIds.at(current));
+        for (int next: successors.at(current)) {
+            if (--inDegree[next] == 0)
+                queue.append(next);
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (inDegree.at(i) > 0)
+            m_unschedulable.append(blockIds.at(i));
+    }
+}
+
+const QList<Identifier> &BlockScheduler::order() const {
+    return m_order;
+}
+
+const QList<Identifier> &BlockScheduler::unschedulable() const {
+    return m_unschedulable;
+}
+
+bool BlockScheduler::complete() const {
+    return m_unschedulable.isEmpty();
+}
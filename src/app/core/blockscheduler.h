@@ -0,0 +1,56 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#ifndef BLOCKSCHEDULER_H
+#define BLOCKSCHEDULER_H
+
+#include <QList>
+#include "base.h"
+
+class BlockManager;
+
+/**
+ * Computes order of blocks evaluation in linear time (Kahn's algorithm).
+ */
+class BlockScheduler {
+    private:
+        const BlockManager* m_manager;
+        QList<Identifier> m_order;
+        QList<Identifier> m_unschedulable;
+
+    public:
+        /**
+         * Creates scheduler for blocks in manager.
+         * @param manager manager with scheme
+         */
+        explicit BlockScheduler(const BlockManager* manager);
+
+        /**
+         * Computes order of blocks, blocks in or behind cycle are unschedulable.
+         */
+        void schedule();
+
+        /**
+         * Getter for computed order.
+         * @return blocks identifiers in order of evaluation
+         */
+        const QList<Identifier> &order() const;
+        /**
+         * Getter for blocks, which could not be ordered.
+         * @return blocks identifiers
+         */
+        const QList<Identifier> &unschedulable() const;
+        /**
+         * Were all blocks scheduled?
+         * @return state
+         */
+        bool complete() const;
+};
+
+#endif // BLOCKSCHEDULER_H
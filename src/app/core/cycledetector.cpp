@@ -0,0 +1,113 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#include "cycledetector.h"
+
+#include <QHash>
+#include <QVector>
+#include <algorithm>
+#include "blockmanager.h"
+
+CycleDetector::CycleDetector(const BlockManager* manager) : m_manager{manager} {}
+
+void CycleDetector::detect() {
+    m_cycles.clear();
+    if (m_manager == nullptr)
+        return;
+
+    // visited in order of identifiers, so reported cycles do not depend on storage order
+    QList<Identifier> blockIds = m_manager->blocks().keys();
+    std::sort(blockIds.begin(), blockIds.end());
+    const int count = blockIds.length();
+
+    QHash<Identifier, int> indexes;
+    indexes.reserve(count);
+    for (int i = 0; i < count; i++)
+        indexes.insert(blockIds.at(i), i);
+
+    QVector<QVector<int> > successors(count);
+    QVector<bool> selfJoined(count, false);
+    for (auto join: m_manager->joins()) {
+        const int from = indexes.value(join->fromBlock(), -1);
+        const int to = indexes.value(join->toBlock(), -1);
+        if (from < 0 || to < 0)
+            continue;
+        successors[from].append(to);
+        if (from == to)
+            selfJoined[from] = true;
+    }
+    for (auto &next: successors)
+        std::sort(next.begin(), next.end());
+
+    QVector<int> index(count, -1);
+    QVector<int> lowLink(count, 0);
+    QVector<bool> onStack(count, false);
+    QVector<int> stack;
+    // explicit call stack of (block, next successor), recursion would overflow on long chains
+    QVector<QPair<int, int> > frames;
+    int counter = 0;
+
+    for (int root = 0; root < count; root++) {
+        if (index.at(root) >= 0)
+            continue;
+
+        index[root] = lowLink[root] = counter++;
+        stack.append(root);
+        onStack[root] = true;
+        frames.append(qMakePair(root, 0));
+
+        while (!frames.isEmpty()) {
+            const int current = frames.last().first;
+            const int next = frames.last().second;
+
+            if (next < successors.at(current).size()) {
+                frames.last().second++;
+                const int successor = successors.at(current).at(next);
+
+                if (index.at(successor) < 0) {
+                    index[successor] = lowLink[successor] = counter++;
+                    stack.append(successor);
+                    onStack[successor] = true;
+                    frames.append(qMakePair(successor, 0));
+                } else if (onStack.at(successor))
+                    lowLink[current] = qMin(lowLink.at(current), index.at(successor));
+                continue;
+            }
+
+            frames.removeLast();
+            if (!frames.isEmpty()) {
+                const int parent = frames.last().first;
+                lowLink[parent] = qMin(lowLink.at(parent), lowLink.at(current));
+            }
+
+            if (lowLink.at(current) != index.at(current))
+                continue;
+
+            // current is root of component
+            QList<Identifier> component;
+            int member;
+            do {
+                member = stack.takeLast();
+                onStack[member] = false;
+                component.append(blockIds.at(member));
+            } while (member != current);
+
+            if (component.length() > 1 || selfJoined.at(current))
+                m_cycles.append(component);
+        }
+    }
+}
+
+const QList<QList<Identifier> > &CycleDetector::cycles() const {
+    return m_cycles;
+}
+
+bool CycleDetector::cycled() const {
+    return !m_cycles.isEmpty();
+}
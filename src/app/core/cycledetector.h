@@ -0,0 +1,50 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#ifndef CYCLEDETECTOR_H
+#define CYCLEDETECTOR_H
+
+#include <QList>
+#include "base.h"
+
+class BlockManager;
+
+/**
+ * Finds cycles in scheme as strongly connected components (Tarjan's algorithm) in linear time.
+ */
+class CycleDetector {
+    private:
+        const BlockManager* m_manager;
+        QList<QList<Identifier> > m_cycles;
+
+    public:
+        /**
+         * Creates detector for scheme in manager.
+         * @param manager manager with scheme
+         */
+        explicit CycleDetector(const BlockManager* manager);
+
+        /**
+         * Searches scheme for all cycles.
+         */
+        void detect();
+
+        /**
+         * Getter for found cycles.
+         * @return blocks identifiers forming each cycle
+         */
+        const QList<QList<Identifier> > &cycles() const;
+        /**
+         * Was any cycle found?
+         * @return state
+         */
+        bool cycled() const;
+};
+
+#endif // CYCLEDETECTOR_H
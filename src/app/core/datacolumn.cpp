@@ -0,0 +1,87 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#include "datacolumn.h"
+
+#include <algorithm>
+
+DataColumn::DataColumn(Type::TypeE type) : m_type{type} {}
+
+void DataColumn::reset(int width, int rows) {
+    m_width = width;
+    m_rows = rows;
+    m_data.resize(width * rows);
+}
+
+void DataColumn::fill(const Value &value, int rows) {
+    if (m_type != Type::Vector) {
+        this->reset(1, rows);
+        std::fill(m_data.begin(), m_data.end(), value.toDouble());
+        return;
+    }
+
+    this->reset(value.length(), rows);
+    for (int row = 0; row < rows; row++)
+        this->setValue(row, value);
+}
+
+void DataColumn::append(const DataColumn &other, int rows) {
+    if (m_rows == 0)
+        m_width = other.width();
+    Q_ASSERT(m_width == other.width());
+
+    const int offset = m_data.size();
+    m_rows += rows;
+    m_data.resize(m_width * m_rows);
+    std::copy(other.data(), other.data() + m_width * rows, m_data.data() + offset);
+}
+
+void DataColumn::slice(const DataColumn &other, int first, int rows) {
+    this->reset(other.width(), rows);
+    const double* begin = other.data() + first * m_width;
+    std::copy(begin, begin + m_width * rows, m_data.data());
+}
+
+Value DataColumn::value(int row) const {
+    const double* item = m_data.constData() + row * m_width;
+    if (m_type != Type::Vector)
+        return Value{*item};
+    return Value::vector(item, m_width);
+}
+
+void DataColumn::setValue(int row, const Value &value) {
+    double* item = m_data.data() + row * m_width;
+    if (m_type != Type::Vector) {
+        *item = value.toDouble();
+        return;
+    }
+
+    Q_ASSERT(value.length() == m_width);
+    std::copy(value.data(), value.data() + m_width, item);
+}
+
+Type::TypeE DataColumn::type() const {
+    return m_type;
+}
+
+int DataColumn::width() const {
+    return m_width;
+}
+
+int DataColumn::rows() const {
+    return m_rows;
+}
+
+double* DataColumn::data() {
+    return m_data.data();
+}
+
+const double* DataColumn::data() const {
+    return m_data.constData();
+}
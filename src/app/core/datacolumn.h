@@ -0,0 +1,100 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#ifndef DATACOLUMN_H
+#define DATACOLUMN_H
+
+#include <QVector>
+#include "base.h"
+#include "blocks/blockport.h"
+
+/**
+ * Column of values of one port over many rows, stored row by row in contiguous array.
+ */
+class DataColumn {
+    private:
+        Type::TypeE m_type;
+        int m_width = 1;
+        int m_rows = 0;
+        QVector<double> m_data;
+
+    public:
+        /**
+         * Creates empty column.
+         * @param type type of values
+         */
+        explicit DataColumn(Type::TypeE type = Type::Scalar);
+
+        /**
+         * Resizes column, allocated memory is kept for reuse.
+         * @param width count of doubles in one row, 1 for scalars
+         * @param rows count of rows
+         */
+        void reset(int width, int rows);
+        /**
+         * Fills all rows with same value.
+         * @param value value to broadcast
+         * @param rows count of rows
+         */
+        void fill(const Value &value, int rows);
+        /**
+         * Appends rows of other column with same width.
+         * @param other column
+         * @param rows count of rows to append
+         */
+        void append(const DataColumn &other, int rows);
+        /**
+         * Replaces content with rows of other column.
+         * @param other column
+         * @param first index of first copied row
+         * @param rows count of rows to copy
+         */
+        void slice(const DataColumn &other, int first, int rows);
+
+        /**
+         * Returns value of one row.
+         * @param row row index
+         * @return value
+         */
+        Value value(int row) const;
+        /**
+         * Sets value of one row, width of column has to match.
+         * @param row row index
+         * @param value new value
+         */
+        void setValue(int row, const Value &value);
+
+        /**
+         * Getter for type of values.
+         * @return type
+         */
+        Type::TypeE type() const;
+        /**
+         * Getter for count of doubles in one row.
+         * @return width
+         */
+        int width() const;
+        /**
+         * Getter for count of rows.
+         * @return rows
+         */
+        int rows() const;
+        /**
+         * Raw data of column.
+         * @return pointer to first row
+         */
+        double* data();
+        /**
+         * Raw data of column.
+         * @return pointer to first row
+         */
+        const double* data() const;
+};
+
+#endif // DATACOLUMN_H
@@ -0,0 +1,100 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#include "debugsession.h"
+
+#include "blockmanager.h"
+
+DebugSession::DebugSession(BlockManager* manager) : m_manager{manager} {}
+
+void DebugSession::start() {
+    m_order = m_manager->plan().order();
+    m_history.fill(Value{}, m_order.length());
+    m_position = 0;
+    m_active = true;
+    m_paused = false;
+}
+
+void DebugSession::stop() {
+    m_order.clear();
+    m_history.clear();
+    m_position = 0;
+    m_active = false;
+    m_paused = false;
+}
+
+bool DebugSession::active() const {
+    return m_active;
+}
+
+bool DebugSession::atEnd() const {
+    return m_position >= m_order.length();
+}
+
+int DebugSession::position() const {
+    return m_position;
+}
+
+Identifier DebugSession::last() const {
+    Q_ASSERT(m_position > 0);
+    return m_order.at(m_position - 1);
+}
+
+bool DebugSession::step() {
+    if (!m_active || this->atEnd())
+        return false;
+
+    Block* block = m_manager->block(m_order.at(m_position));
+    if (block == nullptr)
+        return false;
+
+    m_history[m_position] = block->outputPort()->value();
+    m_manager->evaluateBlock(block->id());
+    m_position++;
+    m_paused = true;
+    return true;
+}
+
+bool DebugSession::stepBack() {
+    if (!m_active || m_position == 0)
+        return false;
+
+    // connected inputs mirror output of their source, so publishing old output restores them too
+    m_position--;
+    m_manager->publishResult(m_order.at(m_position), m_history.at(m_position));
+    m_paused = true;
+    return true;
+}
+
+int DebugSession::continueToBreakpoint() {
+    // block session is paused at is run even with breakpoint, otherwise continue would never move on
+    const bool skipFirst = m_paused;
+    int steps = 0;
+    while (m_active && !this->atEnd()) {
+        if ((steps > 0 || !skipFirst) && m_manager->block(m_order.at(m_position))->breakpoint())
+            break;
+        if (!this->step())
+            break;
+        steps++;
+    }
+    m_paused = true;
+    return steps;
+}
+
+bool DebugSession::runTo(Identifier blockId) {
+    const int target = m_order.indexOf(blockId);
+    if (!m_active || target < m_position)
+        return false;
+
+    while (m_position <= target) {
+        if (!this->step())
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,92 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#ifndef DEBUGSESSION_H
+#define DEBUGSESSION_H
+
+#include <QList>
+#include <QVector>
+#include "base.h"
+
+class BlockManager;
+
+/**
+ * Step by step evaluation over order fixed at start, with history of overwritten results for stepping back.
+ */
+class DebugSession {
+    private:
+        BlockManager* m_manager;
+        QList<Identifier> m_order;
+        QVector<Value> m_history;
+        int m_position = 0;
+        bool m_active = false;
+        bool m_paused = false;
+
+    public:
+        /**
+         * Creates inactive session over scheme in manager.
+         * @param manager manager with scheme
+         */
+        explicit DebugSession(BlockManager* manager);
+
+        /**
+         * Starts session with actual evaluation plan, scheme has to be valid and acyclic.
+         */
+        void start();
+        /**
+         * Ends session, evaluated results are kept.
+         */
+        void stop();
+
+        /**
+         * Is session running?
+         * @return state
+         */
+        bool active() const;
+        /**
+         * Were all blocks evaluated?
+         * @return state
+         */
+        bool atEnd() const;
+        /**
+         * Count of evaluated blocks.
+         * @return position in order
+         */
+        int position() const;
+        /**
+         * Last evaluated block, position has to be nonzero.
+         * @return block identifier
+         */
+        Identifier last() const;
+
+        /**
+         * Evaluates next block.
+         * @return false if there is no block to evaluate
+         */
+        bool step();
+        /**
+         * Restores results from before last step.
+         * @return false if no block was evaluated
+         */
+        bool stepBack();
+        /**
+         * Evaluates blocks until next block has breakpoint or end is reached, block with breakpoint is not evaluated.
+         * Breakpoint of block session is paused in front of is ignored, so repeated call moves past it.
+         * @return count of evaluated blocks
+         */
+        int continueToBreakpoint();
+        /**
+         * Evaluates blocks until given block is evaluated.
+         * @param blockId target block
+         * @return false if block was already evaluated or is not in scheme
+         */
+        bool runTo(Identifier blockId);
+};
+
+#endif // DEBUGSESSION_H
@@ -0,0 +1,121 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#include "evaluationplan.h"
+
+#include <algorithm>
+#include "blockmanager.h"
+#include "blockscheduler.h"
+#include "cycledetector.h"
+
+void EvaluationPlan::build(const BlockManager* manager) {
+    BlockScheduler scheduler{manager};
+    scheduler.schedule();
+
+    m_order = scheduler.order();
+    m_unschedulable = scheduler.unschedulable();
+
+    m_cycles.clear();
+    if (!scheduler.complete()) {
+        CycleDetector detector{manager};
+        detector.detect();
+        m_cycles = detector.cycles();
+    }
+
+    m_positions.clear();
+    m_positions.reserve(m_order.length());
+    m_handles.resize(m_order.length());
+    for (int i = 0; i < m_order.length(); i++) {
+        m_positions.insert(m_order.at(i), i);
+        m_handles[i] = manager->blockHandle(m_order.at(i));
+    }
+
+    m_inputSources.fill(QVector<int>{}, m_order.length());
+    QVector<QList<int> > successors(m_order.length());
+    for (auto join: manager->joins()) {
+        const int from = this->position(join->fromBlock());
+        const int to = this->position(join->toBlock());
+        if (from < 0 || to < 0)
+            continue;
+
+        QVector<int> &sources = m_inputSources[to];
+        if (sources.isEmpty())
+            sources.fill(-1, manager->block(m_handles.at(to))->inputPorts().length());
+        sources[static_cast<int>(join->toPort())] = from;
+        successors[from].append(to);
+    }
+
+    // longest path from sources defines level of block
+    m_levels.clear();
+    QVector<int> blockLevels(m_order.length(), 0);
+    for (int i = 0; i < m_order.length(); i++) {
+        const int level = blockLevels.at(i);
+        while (m_levels.length() <= level)
+            m_levels.append(QVector<int>{});
+        m_levels[level].append(i);
+
+        for (int next: successors.at(i))
+            blockLevels[next] = qMax(blockLevels.at(next), level + 1);
+    }
+
+    // free inputs are numbered on command line, so they are listed by block identifier, not by storage
+    QList<Identifier> blockIds = manager->blocks().keys();
+    std::sort(blockIds.begin(), blockIds.end());
+    m_freeInputs.clear();
+    for (Identifier blockId: blockIds) {
+        for (auto port: manager->block(blockId)->inputPorts()) {
+            if (!port->isConnected())
+                m_freeInputs.append(port);
+        }
+    }
+}
+
+const QList<Identifier> &EvaluationPlan::order() const {
+    return m_order;
+}
+
+int EvaluationPlan::position(Identifier blockId) const {
+    return m_positions.value(blockId, -1);
+}
+
+const SlotMap<Block*>::Handle &EvaluationPlan::handle(int position) const {
+    return m_handles.at(position);
+}
+
+const QList<QVector<int> > &EvaluationPlan::levels() const {
+    return m_levels;
+}
+
+const QVector<int> &EvaluationPlan::inputSources(int position) const {
+    return m_inputSources.at(position);
+}
+
+const QList<Identifier> &EvaluationPlan::unschedulable() const {
+    return m_unschedulable;
+}
+
+const QList<QList<Identifier> > &EvaluationPlan::cycles() const {
+    return m_cycles;
+}
+
+const QList<BlockPort*> &EvaluationPlan::freeInputs() const {
+    return m_freeInputs;
+}
+
+bool EvaluationPlan::hasCycle() const {
+    return !m_unschedulable.isEmpty();
+}
+
+bool EvaluationPlan::inputsValid() const {
+    for (auto port: m_freeInputs) {
+        if (!port->valid())
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,102 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#ifndef EVALUATIONPLAN_H
+#define EVALUATIONPLAN_H
+
+#include <QHash>
+#include <QList>
+#include <QVector>
+#include "base.h"
+#include "slotmap.h"
+
+class Block;
+class BlockManager;
+class BlockPort;
+
+/**
+ * Precomputed plan of scheme evaluation, valid until topology of scheme changes.
+ */
+class EvaluationPlan {
+    private:
+        QList<Identifier> m_order;
+        QVector<SlotMap<Block*>::Handle> m_handles;
+        QHash<Identifier, int> m_positions;
+        QList<QVector<int> > m_levels;
+        QVector<QVector<int> > m_inputSources;
+        QList<Identifier> m_unschedulable;
+        QList<QList<Identifier> > m_cycles;
+        QList<BlockPort*> m_freeInputs;
+
+    public:
+        EvaluationPlan() = default;
+
+        /**
+         * Builds plan from actual topology of scheme.
+         * @param manager manager with scheme
+         */
+        void build(const BlockManager* manager);
+
+        /**
+         * Getter for order of blocks evaluation.
+         * @return blocks identifiers
+         */
+        const QList<Identifier> &order() const;
+        /**
+         * Returns position of block in order of evaluation.
+         * @param blockId block identifier
+         * @return position, -1 for unscheduled block
+         */
+        int position(Identifier blockId) const;
+        /**
+         * Returns handle of block in manager, valid as long as plan.
+         * @param position position of block in order
+         * @return handle
+         */
+        const SlotMap<Block*>::Handle &handle(int position) const;
+        /**
+         * Getter for wavefronts of blocks, blocks in one level do not depend on each other.
+         * @return levels of positions of blocks in order
+         */
+        const QList<QVector<int> > &levels() const;
+        /**
+         * Returns sources of block inputs.
+         * @param position position of block in order
+         * @return position of source block for each input port, -1 for port without join
+         */
+        const QVector<int> &inputSources(int position) const;
+        /**
+         * Getter for blocks, which cannot be evaluated due to cycle.
+         * @return blocks identifiers
+         */
+        const QList<Identifier> &unschedulable() const;
+        /**
+         * Getter for cycles in scheme.
+         * @return blocks identifiers forming each cycle
+         */
+        const QList<QList<Identifier> > &cycles() const;
+        /**
+         * Getter for input ports without join, which values are entered by user.
+         * @return ports
+         */
+        const QList<BlockPort*> &freeInputs() const;
+
+        /**
+         * Is scheme cycled?
+         * @return state
+         */
+        bool hasCycle() const;
+        /**
+         * Are all inputs entered by user valid?
+         * @return state
+         */
+        bool inputsValid() const;
+};
+
+#endif // EVALUATIONPLAN_H
@@ -12,17 +12,21 @@
 //
 
 #include "join.h"
+#include "block.h"
 
 Join::Join(Identifier fromBlock, PortIdentifier fromPort, Identifier toBlock, PortIdentifier toPort,
            QGraphicsItem* parent) :
         QObject{}, Identified{}, m_fromBlock{fromBlock}, m_fromPort{fromPort}, m_toBlock{toBlock}, m_toPort{toPort} {
-    m_view = new JoinView{this->id(), parent};
+    if (Block::headless())
+        return;
 
+    m_view = new JoinView{this->id(), parent};
     connect(m_view, &JoinView::deleteRequest, this, &Join::deleteRequest);
 }
 
 Join::~Join() {
-    m_view->deleteLater();
+    if (m_view != nullptr)
+        m_view->deleteLater();
 }
 
 Identifier Join::fromBlock() const {
@@ -46,5 +50,6 @@ JoinView* Join::view() const {
 }
 
 void Join::setBlockManager(BlockManager* m) {
-    m_view->setBlockManager(m);
+    if (m_view != nullptr)
+        m_view->setBlockManager(m);
 }
@@ -28,7 +28,7 @@ class Join : public QObject, public Identified {
 
         Identifier m_toBlock;
         PortIdentifier m_toPort;
-        JoinView* m_view;
+        JoinView* m_view = nullptr;
 
     public:
         Join(
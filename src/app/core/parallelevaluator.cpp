@@ -0,0 +1,93 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#include "parallelevaluator.h"
+
+#include <QtConcurrent>
+#include "blockmanager.h"
+
+ParallelEvaluator::ParallelEvaluator(BlockManager* manager) : m_manager{manager} {}
+
+void ParallelEvaluator::computeBlock(int position) {
+    // pull inputs from already computed sources, only own result is written
+    QVector<Value> inputs = m_inputs.at(position);
+    const QVector<int> &sources = m_sources.at(position);
+    for (int i = 0; i < sources.size(); i++) {
+        if (sources.at(i) >= 0)
+            inputs[i] = m_results.at(sources.at(i));
+    }
+
+    m_results[position] = m_blocks.at(position)->cachedEvaluate(inputs);
+}
+
+void ParallelEvaluator::setParallel(bool v) {
+    m_parallel = v;
+}
+
+void ParallelEvaluator::load() {
+    const EvaluationPlan &plan = m_manager->plan();
+    const int count = plan.order().length();
+    m_order = plan.order();
+    m_levels = plan.levels();
+    m_blocks.resize(count);
+    m_sources.resize(count);
+    m_inputs.resize(count);
+    for (int position = 0; position < count; position++) {
+        m_blocks[position] = m_manager->block(plan.handle(position));
+        m_sources[position] = plan.inputSources(position);
+        m_inputs[position] = m_blocks.at(position)->inputValues();
+    }
+    m_results.fill(Value{}, count);
+}
+
+bool ParallelEvaluator::run(const QAtomicInt &cancel, QAtomicInt &progress) {
+    int computed = 0;
+    if (!m_parallel) {
+        for (int position = 0; position < m_blocks.size(); position++) {
+            if (cancel.load() != 0)
+                return false;
+            this->computeBlock(position);
+            progress.store(++computed);
+        }
+        return true;
+    }
+
+    for (QVector<int> level: m_levels) {
+        if (cancel.load() != 0)
+            return false;
+        if (level.size() < ParallelEvaluator::s_minParallelWidth) {
+            for (int position: level)
+                this->computeBlock(position);
+        } else {
+            QtConcurrent::blockingMap(level, [this](const int &position) {
+                this->computeBlock(position);
+            });
+        }
+        computed += level.size();
+        progress.store(computed);
+    }
+    return true;
+}
+
+void ParallelEvaluator::publish() const {
+    for (int i = 0; i < m_order.length(); i++)
+        m_manager->publishResult(m_order.at(i), m_results.at(i));
+}
+
+int ParallelEvaluator::length() const {
+    return m_order.length();
+}
+
+void ParallelEvaluator::evaluate() {
+    const QAtomicInt cancel{0};
+    QAtomicInt progress{0};
+    this->load();
+    this->run(cancel, progress);
+    this->publish();
+}
@@ -0,0 +1,87 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#ifndef PARALLELEVALUATOR_H
+#define PARALLELEVALUATOR_H
+
+#include <QAtomicInt>
+#include <QList>
+#include <QVector>
+#include "base.h"
+
+class Block;
+class BlockManager;
+
+/**
+ * Evaluates scheme level by level, blocks of one level are computed on worker pool.
+ * Inputs and plan are copied on load, so run may proceed in other thread while scheme is edited;
+ * blocks must not be deleted until run finishes.
+ */
+class ParallelEvaluator {
+    private:
+        /**
+         * Levels narrower than this are evaluated directly in calling thread.
+         */
+        static constexpr int s_minParallelWidth = 64;
+
+        BlockManager* m_manager;
+        bool m_parallel = true;
+        QList<Identifier> m_order;
+        QList<QVector<int> > m_levels;
+        QVector<Block*> m_blocks;
+        QVector<QVector<int> > m_sources;
+        QVector<QVector<Value> > m_inputs;
+        QVector<Value> m_results;
+
+        /**
+         * Computes result of block without touching ports or views.
+         * @param position position of block in order
+         */
+        void computeBlock(int position);
+
+    public:
+        /**
+         * Creates evaluator over scheme in manager.
+         * @param manager manager with scheme
+         */
+        explicit ParallelEvaluator(BlockManager* manager = nullptr);
+
+        /**
+         * Sets whether wide levels are spread over worker pool, otherwise blocks are computed one by one in order.
+         * @param v state
+         */
+        void setParallel(bool v);
+        /**
+         * Copies plan and values of input ports of valid acyclic scheme, called from thread owning scheme.
+         */
+        void load();
+        /**
+         * Computes all loaded blocks, may be called from any thread.
+         * @param cancel stops run before next block or level when nonzero
+         * @param progress receives count of computed blocks
+         * @return false if run was cancelled
+         */
+        bool run(const QAtomicInt &cancel, QAtomicInt &progress);
+        /**
+         * Publishes computed results to ports in one batch, called from thread owning scheme.
+         */
+        void publish() const;
+        /**
+         * Count of loaded blocks.
+         * @return count
+         */
+        int length() const;
+
+        /**
+         * Evaluates all blocks of valid acyclic scheme and publishes results to ports in one batch.
+         */
+        void evaluate();
+};
+
+#endif // PARALLELEVALUATOR_H
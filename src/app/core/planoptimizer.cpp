@@ -0,0 +1,193 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#include "planoptimizer.h"
+
+#include <QHash>
+#include "blockmanager.h"
+#include "blocks/blocks.h"
+
+PlanOptimizer::PlanOptimizer(const BlockManager* manager) : m_manager{manager} {}
+
+QString PlanOptimizer::structuralKey(const Block* block, QStringList operands) {
+    // order of operands of commutative operations does not change result
+    if (block->classId() == AddBlock::staticClassId() || block->classId() == MulBlock::staticClassId())
+        operands.sort();
+    return block->classId() + "(" + operands.join(";") + ")";
+}
+
+QString PlanOptimizer::literalKey(const Value &value) {
+    // exact digits, display format rounds and would merge different literals
+    if (!value.isValid())
+        return "=";
+    QStringList items;
+    for (int i = 0; i < value.length(); i++)
+        items.append(QString::number(value.data()[i], 'g', 17));
+    if (value.isVector())
+        return QString("={%1}").arg(items.join(","));
+    return "=" + items.join(",");
+}
+
+void PlanOptimizer::setVariables(const QSet<BlockPort*> &ports) {
+    m_variables = ports;
+}
+
+void PlanOptimizer::setObserved(const QSet<Identifier> &blocks) {
+    m_observed = blocks;
+}
+
+bool PlanOptimizer::optimize() {
+    const EvaluationPlan &plan = m_manager->plan();
+    m_schedule.clear();
+    m_outputs.clear();
+    m_folded.clear();
+    m_merged.clear();
+    m_dead.clear();
+    if (plan.hasCycle())
+        return false;
+
+    const int count = plan.order().length();
+    m_constant.fill(false, count);
+    m_live.fill(false, count);
+    m_values.fill(Value{}, count);
+    m_canonical.resize(count);
+    for (int position = 0; position < count; position++)
+        m_canonical[position] = position;
+
+    // sources always precede their targets, so one backward sweep marks everything reaching an output
+    for (int position = count - 1; position >= 0; position--) {
+        const Identifier blockId = plan.order().at(position);
+        const bool observed = m_observed.isEmpty()
+                              ? !m_manager->block(plan.handle(position))->outputPort()->isConnected()
+                              : m_observed.contains(blockId);
+        if (observed)
+            m_live[position] = true;
+        if (!m_live.at(position))
+            continue;
+
+        for (int source: plan.inputSources(position)) {
+            if (source >= 0)
+                m_live[source] = true;
+        }
+    }
+
+    QHash<QString, int> representatives;
+    for (int position = 0; position < count; position++) {
+        const Identifier blockId = plan.order().at(position);
+        Block* block = m_manager->block(plan.handle(position));
+        if (!m_live.at(position)) {
+            m_dead.append(blockId);
+            continue;
+        }
+
+        const QVector<int> &sources = plan.inputSources(position);
+        const QList<BlockPort*> ports = block->inputPorts();
+        QVector<Value> inputs = block->inputValues();
+        bool constant = true;
+        for (int i = 0; i < ports.length() && constant; i++) {
+            const int source = sources.value(i, -1);
+            if (source >= 0) {
+                constant = m_constant.at(source);
+                inputs[i] = m_values.at(source);
+            } else
+                constant = !m_variables.contains(ports.at(i)) && ports.at(i)->valid();
+        }
+
+        if (constant) {
+            m_constant[position] = true;
+            m_values[position] = block->evaluate(inputs);
+            m_folded.append(blockId);
+            continue;
+        }
+
+        // folded sources count as literals, so duplicates over equal constants are merged too
+        QStringList operands;
+        for (int i = 0; i < ports.length(); i++) {
+            const int source = sources.value(i, -1);
+            if (source >= 0 && m_constant.at(source))
+                operands.append(PlanOptimizer::literalKey(m_values.at(source)));
+            else if (source >= 0)
+                operands.append(QString("#%1").arg(m_canonical.at(source)));
+            else if (m_variables.contains(ports.at(i)))
+                operands.append(QString("$%1").arg(reinterpret_cast<quintptr>(ports.at(i))));
+            else
+                operands.append(PlanOptimizer::literalKey(ports.at(i)->value()));
+        }
+
+        const QString key = PlanOptimizer::structuralKey(block, operands);
+        if (representatives.contains(key)) {
+            m_canonical[position] = representatives.value(key);
+            m_merged.append(blockId);
+        } else {
+            representatives.insert(key, position);
+            m_schedule.append(position);
+        }
+    }
+
+    for (int position = 0; position < count; position++) {
+        const Identifier blockId = plan.order().at(position);
+        if (m_observed.isEmpty() ? !m_manager->block(plan.handle(position))->outputPort()->isConnected()
+                                 : m_observed.contains(blockId))
+            m_outputs.append(blockId);
+    }
+    return true;
+}
+
+const QList<int> &PlanOptimizer::schedule() const {
+    return m_schedule;
+}
+
+const QList<Identifier> &PlanOptimizer::outputs() const {
+    return m_outputs;
+}
+
+bool PlanOptimizer::isConstant(int position) const {
+    return m_constant.at(position);
+}
+
+bool PlanOptimizer::isLive(int position) const {
+    return m_live.at(position);
+}
+
+int PlanOptimizer::canonical(int position) const {
+    return m_canonical.at(position);
+}
+
+const Value &PlanOptimizer::constantValue(int position) const {
+    return m_values.at(position);
+}
+
+const QList<Identifier> &PlanOptimizer::folded() const {
+    return m_folded;
+}
+
+const QList<Identifier> &PlanOptimizer::merged() const {
+    return m_merged;
+}
+
+const QList<Identifier> &PlanOptimizer::dead() const {
+    return m_dead;
+}
+
+QString PlanOptimizer::report() const {
+    const auto describe = [this](const QList<Identifier> &blocks) {
+        QStringList names;
+        for (Identifier blockId: blocks)
+            names.append(QString("%1#%2").arg(m_manager->block(blockId)->classId()).arg(blockId));
+        return names.join(", ");
+    };
+
+    QString report = QString("Evaluated %1 of %2 blocks per run.\n")
+            .arg(m_schedule.length())
+            .arg(m_manager->plan().order().length());
+    report += QString("Folded %1 constant blocks: %2\n").arg(m_folded.length()).arg(describe(m_folded));
+    report += QString("Merged %1 duplicate blocks: %2\n").arg(m_merged.length()).arg(describe(m_merged));
+    report += QString("Removed %1 dead blocks: %2\n").arg(m_dead.length()).arg(describe(m_dead));
+    return report;
+}
@@ -0,0 +1,138 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#ifndef PLANOPTIMIZER_H
+#define PLANOPTIMIZER_H
+
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "base.h"
+
+class Block;
+class BlockManager;
+class BlockPort;
+
+/**
+ * Pass over evaluation plan, which folds blocks depending only on literal values,
+ * merges structurally identical blocks and drops blocks not reaching any observed output.
+ */
+class PlanOptimizer {
+    private:
+        const BlockManager* m_manager;
+        QSet<BlockPort*> m_variables;
+        QSet<Identifier> m_observed;
+
+        QVector<bool> m_constant;
+        QVector<bool> m_live;
+        QVector<int> m_canonical;
+        QVector<Value> m_values;
+        QList<int> m_schedule;
+        QList<Identifier> m_outputs;
+        QList<Identifier> m_folded;
+        QList<Identifier> m_merged;
+        QList<Identifier> m_dead;
+
+    public:
+        /**
+         * Creates optimizer over scheme in manager.
+         * @param manager manager with scheme
+         */
+        explicit PlanOptimizer(const BlockManager* manager);
+
+        /**
+         * Builds structural key of block, blocks with same key compute same result.
+         * @param block block
+         * @param operands keys of inputs, equal for same source or same literal value
+         * @return key
+         */
+        static QString structuralKey(const Block* block, QStringList operands);
+        /**
+         * Key of literal value of port for structural key.
+         * @param value literal value
+         * @return operand key
+         */
+        static QString literalKey(const Value &value);
+
+        /**
+         * Sets input ports, which change between evaluations, other free ports are constant.
+         * @param ports variable ports
+         */
+        void setVariables(const QSet<BlockPort*> &ports);
+        /**
+         * Sets blocks, whose results are needed, empty means all blocks with unconnected output.
+         * @param blocks observed blocks
+         */
+        void setObserved(const QSet<Identifier> &blocks);
+
+        /**
+         * Runs the pass, constant blocks are evaluated once during it.
+         * @return false if scheme is not acyclic
+         */
+        bool optimize();
+
+        /**
+         * Positions of live blocks depending on variable ports, in order of evaluation.
+         * @return positions in plan
+         */
+        const QList<int> &schedule() const;
+        /**
+         * Observed blocks in order of evaluation.
+         * @return block identifiers
+         */
+        const QList<Identifier> &outputs() const;
+        /**
+         * Checks if block on position was folded.
+         * @param position position in plan
+         * @return true for constant block
+         */
+        bool isConstant(int position) const;
+        /**
+         * Checks if block on position reaches observed output.
+         * @param position position in plan
+         * @return true for live block
+         */
+        bool isLive(int position) const;
+        /**
+         * Position of block computing same result, result of merged block is taken from there.
+         * @param position position in plan
+         * @return position of representative, same position for unmerged block
+         */
+        int canonical(int position) const;
+        /**
+         * Folded result of constant block.
+         * @param position position in plan
+         * @return result
+         */
+        const Value &constantValue(int position) const;
+        /**
+         * Live blocks evaluated during optimization.
+         * @return block identifiers
+         */
+        const QList<Identifier> &folded() const;
+        /**
+         * Live blocks evaluated by their structurally identical representative.
+         * @return block identifiers
+         */
+        const QList<Identifier> &merged() const;
+        /**
+         * Blocks not reaching any observed output.
+         * @return block identifiers
+         */
+        const QList<Identifier> &dead() const;
+        /**
+         * Human readable summary of last pass.
+         * @return report
+         */
+        QString report() const;
+};
+
+#endif // PLANOPTIMIZER_H
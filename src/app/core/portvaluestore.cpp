@@ -0,0 +1,79 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#include "portvaluestore.h"
+
+#include <algorithm>
+
+int PortValueStore::addScalar() {
+    m_scalars.append(0.);
+    return m_scalars.size() - 1;
+}
+
+int PortValueStore::addVector() {
+    m_offsets.append(m_arena.size());
+    m_lengths.append(0);
+    return m_lengths.size() - 1;
+}
+
+void PortValueStore::setVectorLength(int index, int length) {
+    if (m_lengths.at(index) == length)
+        return;
+    m_lengths[index] = length;
+    m_layoutDirty = true;
+}
+
+void PortValueStore::layout() {
+    if (!m_layoutDirty)
+        return;
+
+    int offset = 0;
+    for (int i = 0; i < m_lengths.size(); i++) {
+        m_offsets[i] = offset;
+        offset += m_lengths.at(i);
+    }
+    m_arena.resize(offset);
+    m_layoutDirty = false;
+}
+
+double* PortValueStore::scalars() {
+    return m_scalars.data();
+}
+
+const double* PortValueStore::scalars() const {
+    return m_scalars.constData();
+}
+
+double* PortValueStore::vector(int index) {
+    return m_arena.data() + m_offsets.at(index);
+}
+
+const double* PortValueStore::vector(int index) const {
+    return m_arena.constData() + m_offsets.at(index);
+}
+
+int PortValueStore::vectorLength(int index) const {
+    return m_lengths.at(index);
+}
+
+Value PortValueStore::value(int index, bool vector) const {
+    if (!vector)
+        return Value{m_scalars.at(index)};
+    return Value::vector(this->vector(index), m_lengths.at(index));
+}
+
+void PortValueStore::setValue(int index, bool vector, const Value &value) {
+    if (!vector) {
+        m_scalars[index] = value.toDouble();
+        return;
+    }
+
+    Q_ASSERT(value.length() == m_lengths.at(index));
+    std::copy(value.data(), value.data() + value.length(), this->vector(index));
+}
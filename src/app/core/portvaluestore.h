@@ -0,0 +1,97 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#ifndef PORTVALUESTORE_H
+#define PORTVALUESTORE_H
+
+#include <QVector>
+#include "value.h"
+
+/**
+ * Values of ports stored as structure of arrays: all scalars in one array, all vectors one after another in arena.
+ * Slots are addressed by index returned on allocation, scalar and vector slots are numbered separately.
+ */
+class PortValueStore {
+    private:
+        QVector<double> m_scalars;
+        QVector<double> m_arena;
+        QVector<int> m_offsets;
+        QVector<int> m_lengths;
+        bool m_layoutDirty = false;
+
+    public:
+        PortValueStore() = default;
+
+        /**
+         * Allocates scalar slot with zero value.
+         * @return slot index
+         */
+        int addScalar();
+        /**
+         * Allocates empty vector slot.
+         * @return slot index
+         */
+        int addVector();
+        /**
+         * Sets length of vector slot, takes effect on next layout.
+         * @param index slot index
+         * @param length count of items
+         */
+        void setVectorLength(int index, int length);
+        /**
+         * Places vectors in arena by their lengths, content of vectors is undefined after changed layout.
+         */
+        void layout();
+
+        /**
+         * Array of all scalars.
+         * @return first scalar
+         */
+        double* scalars();
+        /**
+         * Array of all scalars.
+         * @return first scalar
+         */
+        const double* scalars() const;
+        /**
+         * Items of vector slot in arena.
+         * @param index slot index
+         * @return first item
+         */
+        double* vector(int index);
+        /**
+         * Items of vector slot in arena.
+         * @param index slot index
+         * @return first item
+         */
+        const double* vector(int index) const;
+        /**
+         * Length of vector slot.
+         * @param index slot index
+         * @return count of items
+         */
+        int vectorLength(int index) const;
+
+        /**
+         * Copies slot into port value.
+         * @param index slot index
+         * @param vector is slot vector?
+         * @return value
+         */
+        Value value(int index, bool vector) const;
+        /**
+         * Copies port value into slot, vector slot has to be laid out for length of value.
+         * @param index slot index
+         * @param vector is slot vector?
+         * @param value value
+         */
+        void setValue(int index, bool vector, const Value &value);
+};
+
+#endif // PORTVALUESTORE_H
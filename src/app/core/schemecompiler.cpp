@@ -0,0 +1,85 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#include "schemecompiler.h"
+
+#include "blockmanager.h"
+#include "blocks/blocks.h"
+#include "planoptimizer.h"
+
+bool SchemeCompiler::compile(const BlockManager* manager, SchemeProgram* program) {
+    static const QHash<QString, SchemeProgram::Opcode> opcodes{
+            {AddBlock::staticClassId(),      SchemeProgram::Add},
+            {SubBlock::staticClassId(),      SchemeProgram::Sub},
+            {MulBlock::staticClassId(),      SchemeProgram::Mul},
+            {SinBlock::staticClassId(),      SchemeProgram::Sin},
+            {CosBlock::staticClassId(),      SchemeProgram::Cos},
+            {VectInitBlock::staticClassId(), SchemeProgram::VectInit},
+            {VectMagBlock::staticClassId(),  SchemeProgram::VectMag},
+    };
+
+    const EvaluationPlan &plan = manager->plan();
+    if (plan.hasCycle())
+        return false;
+
+    QVector<int> outputRegisters(plan.order().length(), -1);
+    QHash<QString, int> computed;
+    for (int position = 0; position < plan.order().length(); position++) {
+        const Block* block = manager->block(plan.handle(position));
+        if (!opcodes.contains(block->classId()))
+            return false;
+
+        const QVector<int> &sources = plan.inputSources(position);
+        const bool vectorOutput = block->outputPort()->type() == Type::Vector;
+
+        // identical block over identical operands reuses already computed register,
+        // literals are bound per port and reloaded on each run, so only shared registers can match
+        QStringList operandKeys;
+        for (int i = 0; i < block->inputPorts().length(); i++) {
+            if (i < sources.size() && sources.at(i) >= 0)
+                operandKeys.append(QString("#%1").arg(outputRegisters.at(sources.at(i))));
+            else
+                operandKeys.append(QString("@%1.%2").arg(block->id()).arg(i));
+        }
+        const QString key = PlanOptimizer::structuralKey(block, operandKeys);
+        if (computed.contains(key)) {
+            outputRegisters[position] = computed.value(key);
+            program->addOutput(block->id(), outputRegisters.at(position), vectorOutput);
+            continue;
+        }
+
+        QVector<int> operands;
+        for (int i = 0; i < block->inputPorts().length(); i++) {
+            if (i < sources.size() && sources.at(i) >= 0) {
+                operands.append(outputRegisters.at(sources.at(i)));
+                continue;
+            }
+
+            BlockPort* port = block->inputPorts().at(i);
+            const int reg = program->addRegister(port->type() == Type::Vector);
+            program->bindInput(port, reg);
+            operands.append(reg);
+        }
+
+        const SchemeProgram::Opcode opcode = opcodes.value(block->classId());
+        const bool unary = opcode == SchemeProgram::Sin ||
+                           opcode == SchemeProgram::Cos ||
+                           opcode == SchemeProgram::VectMag;
+        if (operands.size() != (unary ? 1 : 2))
+            return false;
+
+        const int target = program->addRegister(vectorOutput);
+        program->addInstruction(opcode, target, operands.at(0), unary ? -1 : operands.at(1));
+        program->addOutput(block->id(), target, vectorOutput);
+        outputRegisters[position] = target;
+        computed.insert(key, target);
+    }
+
+    return true;
+}
@@ -0,0 +1,29 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#ifndef SCHEMECOMPILER_H
+#define SCHEMECOMPILER_H
+
+#include "schemeprogram.h"
+
+/**
+ * Lowers validated scheme into program for register machine.
+ */
+class SchemeCompiler {
+    public:
+        /**
+         * Compiles scheme in order given by its evaluation plan, identical blocks over same operands share one instruction.
+         * @param manager manager with acyclic scheme
+         * @param program target program, should be empty
+         * @return false, if scheme contains block without opcode or is cycled
+         */
+        static bool compile(const BlockManager* manager, SchemeProgram* program);
+};
+
+#endif // SCHEMECOMPILER_H
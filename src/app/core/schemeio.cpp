@@ -10,6 +10,8 @@
 #include "schemeio.h"
 
 #include <QJsonArray>
+#include <algorithm>
+#include <app/core/blocks/blocks.h>
 
 SchemeIO::SchemeIO(BlockManager* manager, QObject* parent) : QObject(parent) {
     m_manager = manager;
@@ -23,17 +25,24 @@ QJsonObject SchemeIO::exportToJson() const {
     QJsonArray blocksJsonArr;
     QJsonArray joinsJsonArr;
 
-    for (auto block: m_manager->blocks().values()) {
+    // saved files are compared and diffed, so items are written by identifier, not in storage order
+    QList<Identifier> blockIds = m_manager->blocks().keys();
+    std::sort(blockIds.begin(), blockIds.end());
+    for (Identifier blockId: blockIds) {
+        Block* block = m_manager->block(blockId);
         QJsonObject blockJson = m_manager->blockToJson(block);
         // need deeper info
         blockJson["id"] = QJsonValue::fromVariant(block->id());
-        blockJson["x"] = block->view()->pos().x();
-        blockJson["y"] = block->view()->pos().y();
+        blockJson["x"] = block->position().x();
+        blockJson["y"] = block->position().y();
 
         blocksJsonArr.append(blockJson);
     }
 
-    for (auto join: m_manager->joins().values()) {
+    QList<Identifier> joinIds = m_manager->joins().keys();
+    std::sort(joinIds.begin(), joinIds.end());
+    for (Identifier joinId: joinIds) {
+        Join* join = m_manager->join(joinId);
         QJsonObject joinObject;
         joinObject["fromBlock"] = QJsonValue::fromVariant(join->fromBlock());
         joinObject["fromPort"] = QJsonValue::fromVariant(join->fromPort());
@@ -49,8 +58,105 @@ QJsonObject SchemeIO::exportToJson() const {
     return json;
 }
 
+QString SchemeIO::exportToCpp(const QString &name) const {
+    static const QMap<QString, QString> expressions{
+            {AddBlock::staticClassId(),      "%1 + %2"},
+            {SubBlock::staticClassId(),      "%1 - %2"},
+            {MulBlock::staticClassId(),      "%1 * %2"},
+            {SinBlock::staticClassId(),      "std::sin(%1)"},
+            {CosBlock::staticClassId(),      "std::cos(%1)"},
+            {VectInitBlock::staticClassId(), "std::vector<double>{%1, %2}"},
+            {VectMagBlock::staticClassId(),  "blockscheme_detail::magnitude(%1)"},
+    };
+    const auto cppType = [](Type::TypeE type) {
+        return (type == Type::Vector) ? QString("std::vector<double>") : QString("double");
+    };
+    const auto cppValue = [](const Value &value, Type::TypeE type) {
+        if (type != Type::Vector)
+            return QString::number(value.toDouble(), 'g', 17);
+        QStringList items;
+        for (int i = 0; i < value.length(); i++)
+            items.append(QString::number(value.data()[i], 'g', 17));
+        return QString("{%1}").arg(items.join(", "));
+    };
+
+    if (m_manager == nullptr)
+        return "";
+
+    const EvaluationPlan &plan = m_manager->plan();
+    if (plan.hasCycle())
+        return "";
+
+    QStringList parameters, body, fields, results;
+    for (int position = 0; position < plan.order().length(); position++) {
+        const Block* block = m_manager->block(plan.order().at(position));
+        const QString blockName = QString("b%1").arg(block->id());
+        if (!expressions.contains(block->classId()))
+            return "";
+
+        QString expression = expressions.value(block->classId());
+        const QVector<int> &sources = plan.inputSources(position);
+        for (int i = 0; i < block->inputPorts().length(); i++) {
+            if (i < sources.size() && sources.at(i) >= 0) {
+                expression = expression.arg(QString("b%1_out").arg(plan.order().at(sources.at(i))));
+                continue;
+            }
+
+            const BlockPort* port = block->inputPorts().at(i);
+            const QString parameter = QString("%1_in%2").arg(blockName).arg(i);
+            const QString declaration = (port->type() == Type::Vector) ? "const %1 &%2 = %3" : "%1 %2 = %3";
+            parameters.append(declaration.arg(cppType(port->type()), parameter,
+                                              cppValue(port->value(), port->type())));
+            expression = expression.arg(parameter);
+        }
+
+        const QString outputType = cppType(block->outputPort()->type());
+        body.append(QString("    const %1 %2_out = %3; // %4")
+                            .arg(outputType, blockName, expression, block->classId()));
+        if (!block->outputPort()->isConnected()) {
+            fields.append(QString("    %1 %2_out;").arg(outputType, blockName));
+            results.append(QString("%1_out").arg(blockName));
+        }
+    }
+
+    const QString guard = QString("BLOCKSCHEME_%1_H").arg(name.toUpper());
+    QStringList header{
+            "// Generated by Block Editor, do not edit.",
+            QString("#ifndef %1").arg(guard),
+            QString("#define %1").arg(guard),
+            "",
+            "#include <cmath>",
+            "#include <vector>",
+            "",
+            "#ifndef BLOCKSCHEME_DETAIL",
+            "#define BLOCKSCHEME_DETAIL",
+            "namespace blockscheme_detail {",
+            "    inline double magnitude(const std::vector<double> &v) {",
+            "        double sum = 0;",
+            "        for (double item: v)",
+            "            sum += item * item;",
+            "        return std::sqrt(sum);",
+            "    }",
+            "}",
+            "#endif",
+            "",
+            QString("struct %1_result {").arg(name),
+    };
+    header << fields
+           << "};"
+           << ""
+           << QString("inline %1_result %1(%2) {").arg(name, parameters.join(", "))
+           << body
+           << QString("    return %1_result{%2};").arg(name, results.join(", "))
+           << "}"
+           << ""
+           << QString("#endif // %1").arg(guard)
+           << "";
+    return header.join("\n");
+}
+
 QString SchemeIO::jsonValid(const QJsonObject &scheme) const {
-    QMap<Identifier, QString> blocksTypes;
+    QHash<Identifier, QString> blocksTypes;
     if (scheme.keys().toSet() != QSet<QString>{"blocks", "joins"})
         return tr("Scheme structure is not valid.");
 
@@ -68,11 +174,14 @@ QString SchemeIO::jsonValid(const QJsonObject &scheme) const {
             {"toPort",    QJsonValue::Double}
     };
 
-    // check blocks
-    for (auto blockJson: scheme["blocks"].toArray()) {
+    const QSet<QString> blockKeys = blockExpectedTypes.keys().toSet() | QSet<QString>{"input_values", "output_value"};
+    const QJsonArray blocks = scheme["blocks"].toArray();
+    blocksTypes.reserve(blocks.size());
+
+    // check blocks, lookups are hashed so validation stays linear in size of scheme
+    for (auto blockJson: blocks) {
         const QJsonObject blockObject = blockJson.toObject();
-        if (blockObject.keys().toSet() !=
-            (blockExpectedTypes.keys().toSet() | QSet<QString>{"input_values", "output_value"})) {
+        if (blockObject.keys().toSet() != blockKeys) {
             return tr("Block structure is not valid.");
         }
 
@@ -85,7 +194,7 @@ QString SchemeIO::jsonValid(const QJsonObject &scheme) const {
             return tr("Uknown block type.");
 
         const Identifier blockId = blockObject["id"].toVariant().toUInt();
-        if (blocksTypes.keys().contains(blockId))
+        if (blocksTypes.contains(blockId))
             return tr("Multiple blocks with same id.");
 
         blocksTypes.insert(blockId, blockObject["type"].toString());
@@ -107,9 +216,9 @@ QString SchemeIO::jsonValid(const QJsonObject &scheme) const {
 
         if (fromPort != 0)
             return tr("Output port id is too large.");
-        if (!blocksTypes.keys().contains(toBlock) || !blocksTypes.keys().contains(fromBlock))
+        if (!blocksTypes.contains(toBlock) || !blocksTypes.contains(fromBlock))
             return tr("Invalid blocks ids in join");
-        if (Block::blockInputsCount(blocksTypes[toBlock]) <= static_cast<int>(toPort))
+        if (Block::blockInputsCount(blocksTypes.value(toBlock)) <= static_cast<int>(toPort))
             return tr("Input port id is too large.");
     }
 
@@ -135,11 +244,12 @@ void SchemeIO::loadFromJson(QJsonObject scheme, QGraphicsWidget* parent) {
 
         mappedBlocksIds[blockObject["id"].toVariant().toUInt()] = block->id();
 
-        block->view()->setCopyable(false);
-        block->view()->setFlag(QGraphicsItem::ItemIsSelectable);
-        block->view()->setFlag(QGraphicsItem::ItemIsMovable);
-        block->view()->setX(blockObject["x"].toDouble());
-        block->view()->setY(blockObject["y"].toDouble());
+        block->setPosition(QPointF{blockObject["x"].toDouble(), blockObject["y"].toDouble()});
+        if (block->view() != nullptr) {
+            block->view()->setCopyable(false);
+            block->view()->setFlag(QGraphicsItem::ItemIsSelectable);
+            block->view()->setFlag(QGraphicsItem::ItemIsMovable);
+        }
     }
 
     for (auto joinJson: scheme["joins"].toArray()) {
@@ -29,6 +29,13 @@ class SchemeIO : public QObject {
          * @return serialized
          */
         QJsonObject exportToJson() const;
+        /**
+         * Exports scheme as self-contained C++ header with one inline function.
+         * Unconnected input ports are parameters, unconnected output ports are returned.
+         * @param name name of generated function
+         * @return header source, empty for cycled scheme or unknown block type
+         */
+        QString exportToCpp(const QString &name) const;
         /**
          * Loads from scheme into manager.
          * @param scheme to load
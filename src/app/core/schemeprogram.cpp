@@ -0,0 +1,108 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#include "schemeprogram.h"
+
+#include <QtMath>
+#include "blockmanager.h"
+#include "vectorkernels.h"
+
+int SchemeProgram::addRegister(bool vector) {
+    return vector ? m_registers.addVector() : m_registers.addScalar();
+}
+
+void SchemeProgram::addInstruction(SchemeProgram::Opcode opcode, int target, int first, int second) {
+    m_instructions.append(Instruction{opcode, target, first, second});
+    if (opcode == VectInit)
+        m_registers.setVectorLength(target, 2);
+}
+
+void SchemeProgram::bindInput(BlockPort* port, int reg) {
+    m_bindings.append(Binding{port, reg, port->type() == Type::Vector});
+}
+
+void SchemeProgram::addOutput(Identifier blockId, int reg, bool vector) {
+    m_outputs.append(Output{blockId, reg, vector});
+}
+
+void SchemeProgram::loadInputs() {
+    // lengths of vector inputs may change between runs, arena is laid out before copying
+    for (const Binding &binding: m_bindings) {
+        if (binding.vector)
+            m_registers.setVectorLength(binding.reg, binding.port->value().length());
+    }
+    m_registers.layout();
+
+    for (const Binding &binding: m_bindings)
+        m_registers.setValue(binding.reg, binding.vector, binding.port->value());
+}
+
+void SchemeProgram::execute(int from, int to) {
+    double* scalars = m_registers.scalars();
+    const Instruction* instructions = m_instructions.constData();
+
+    for (int index = from; index < to; index++) {
+        const Instruction &i = instructions[index];
+        switch (i.opcode) {
+            case Add:
+                scalars[i.target] = scalars[i.first] + scalars[i.second];
+                break;
+            case Sub:
+                scalars[i.target] = scalars[i.first] - scalars[i.second];
+                break;
+            case Mul:
+                scalars[i.target] = scalars[i.first] * scalars[i.second];
+                break;
+            case Sin:
+                scalars[i.target] = qSin(scalars[i.first]);
+                break;
+            case Cos:
+                scalars[i.target] = qCos(scalars[i.first]);
+                break;
+            case VectInit: {
+                double* target = m_registers.vector(i.target);
+                target[0] = scalars[i.first];
+                target[1] = scalars[i.second];
+                break;
+            }
+            case VectMag:
+                scalars[i.target] = VectorKernels::magnitude(m_registers.vector(i.first),
+                                                             m_registers.vectorLength(i.first));
+                break;
+        }
+    }
+}
+
+void SchemeProgram::run() {
+    this->execute(0, m_instructions.size());
+}
+
+bool SchemeProgram::run(const QAtomicInt &cancel, QAtomicInt &progress) {
+    for (int from = 0; from < m_instructions.size(); from += SchemeProgram::s_sliceLength) {
+        if (cancel.load() != 0)
+            return false;
+        const int to = qMin(from + SchemeProgram::s_sliceLength, m_instructions.size());
+        this->execute(from, to);
+        progress.store(to);
+    }
+    return true;
+}
+
+void SchemeProgram::publish(BlockManager* manager) const {
+    for (const Output &output: m_outputs)
+        manager->publishResult(output.blockId, this->value(output.reg, output.vector));
+}
+
+Value SchemeProgram::value(int reg, bool vector) const {
+    return m_registers.value(reg, vector);
+}
+
+int SchemeProgram::length() const {
+    return m_instructions.size();
+}
@@ -0,0 +1,151 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#ifndef SCHEMEPROGRAM_H
+#define SCHEMEPROGRAM_H
+
+#include <QAtomicInt>
+#include <QVector>
+#include "base.h"
+#include "blocks/blockport.h"
+#include "portvaluestore.h"
+
+class BlockManager;
+
+/**
+ * Scheme compiled into flat instruction stream over register files, with interpreter.
+ */
+class SchemeProgram {
+    public:
+        /**
+         * Operations, one for each type of block.
+         */
+        enum Opcode {
+            Add,
+            Sub,
+            Mul,
+            Sin,
+            Cos,
+            VectInit,
+            VectMag
+        };
+
+        /**
+         * One instruction, operands are indexes to scalar or vector register file given by opcode.
+         */
+        struct Instruction {
+            Opcode opcode;
+            int target;
+            int first;
+            int second;
+        };
+
+        /**
+         * Register filled from input port entered by user.
+         */
+        struct Binding {
+            BlockPort* port;
+            int reg;
+            bool vector;
+        };
+
+        /**
+         * Register holding result of block.
+         */
+        struct Output {
+            Identifier blockId;
+            int reg;
+            bool vector;
+        };
+
+    private:
+        /**
+         * Count of instructions executed between checks for cancellation.
+         */
+        static constexpr int s_sliceLength = 4096;
+
+        QVector<Instruction> m_instructions;
+        PortValueStore m_registers;
+        QVector<Binding> m_bindings;
+        QVector<Output> m_outputs;
+
+        /**
+         * Executes range of instructions.
+         * @param from index of first instruction
+         * @param to index after last instruction
+         */
+        void execute(int from, int to);
+
+    public:
+        SchemeProgram() = default;
+
+        /**
+         * Allocates new register.
+         * @param vector is register for vector?
+         * @return register index
+         */
+        int addRegister(bool vector);
+        /**
+         * Appends instruction to program.
+         * @param opcode operation
+         * @param target register for result
+         * @param first first operand register
+         * @param second second operand register, -1 for unary operation
+         */
+        void addInstruction(Opcode opcode, int target, int first, int second = -1);
+        /**
+         * Binds register to input port, which is loaded before each run.
+         * @param port input port
+         * @param reg register index
+         */
+        void bindInput(BlockPort* port, int reg);
+        /**
+         * Registers result of block.
+         * @param blockId block identifier
+         * @param reg register index
+         * @param vector is result vector?
+         */
+        void addOutput(Identifier blockId, int reg, bool vector);
+
+        /**
+         * Loads actual values of bound input ports into registers.
+         */
+        void loadInputs();
+        /**
+         * Executes all instructions.
+         */
+        void run();
+        /**
+         * Executes all instructions in slices, can be interrupted from other thread.
+         * @param cancel stops run before next slice when nonzero
+         * @param progress receives count of executed instructions
+         * @return false if run was cancelled
+         */
+        bool run(const QAtomicInt &cancel, QAtomicInt &progress);
+        /**
+         * Publishes results of all blocks into scheme.
+         * @param manager manager of compiled scheme
+         */
+        void publish(BlockManager* manager) const;
+
+        /**
+         * Returns value of register as port data.
+         * @param reg register index
+         * @param vector is register vector?
+         * @return value
+         */
+        Value value(int reg, bool vector) const;
+        /**
+         * Getter for count of instructions.
+         * @return count
+         */
+        int length() const;
+};
+
+#endif // SCHEMEPROGRAM_H
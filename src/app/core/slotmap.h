@@ -0,0 +1,253 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+#include <QHash>
+#include <QList>
+#include <QVector>
+#include "base.h"
+
+/**
+ * Storage of items keyed by identifier, with items kept densely in one array.
+ * Items are addressed by identifier or by generational handle; handle of removed item is detected as stale,
+ * even if its slot is reused. Removal moves last item into freed place, so order of items is not stable.
+ */
+template<typename T>
+class SlotMap {
+    public:
+        /**
+         * Index of slot with generation of its content.
+         */
+        struct Handle {
+            int index = -1;
+            quint32 generation = 0;
+        };
+
+        typedef typename QVector<T>::const_iterator const_iterator;
+
+    private:
+        /**
+         * Slot pointing to dense position of item, -1 for free slot.
+         */
+        struct Slot {
+            quint32 generation = 0;
+            int dense = -1;
+        };
+
+        QVector<Slot> m_slots;
+        QVector<int> m_freeSlots;
+        QVector<T> m_values;
+        QVector<Identifier> m_keys;
+        QVector<int> m_denseSlots;
+        QHash<Identifier, Handle> m_handles;
+
+    public:
+        /**
+         * Inserts item, item with same identifier is replaced.
+         * @param key identifier
+         * @param value item
+         * @return handle of item
+         */
+        Handle insert(Identifier key, const T &value);
+        /**
+         * Removes item.
+         * @param key identifier
+         * @return was item present?
+         */
+        bool remove(Identifier key);
+        /**
+         * Removes item and returns it.
+         * @param key identifier
+         * @return item, default value if not present
+         */
+        T take(Identifier key);
+
+        /**
+         * Is item present?
+         * @param key identifier
+         * @return state
+         */
+        bool contains(Identifier key) const;
+        /**
+         * Is handle valid, i.e. its item was not removed?
+         * @param handle handle
+         * @return state
+         */
+        bool contains(const Handle &handle) const;
+        /**
+         * Returns handle of item.
+         * @param key identifier
+         * @return handle, invalid handle if not present
+         */
+        Handle handle(Identifier key) const;
+        /**
+         * Returns item by identifier.
+         * @param key identifier
+         * @param defaultValue returned if not present
+         * @return item
+         */
+        T value(Identifier key, const T &defaultValue = T()) const;
+        /**
+         * Returns item by handle.
+         * @param handle handle
+         * @param defaultValue returned for stale handle
+         * @return item
+         */
+        T value(const Handle &handle, const T &defaultValue = T()) const;
+
+        /**
+         * Identifiers of all items in storage order.
+         * @return identifiers
+         */
+        QList<Identifier> keys() const;
+        /**
+         * All items in storage order.
+         * @return items
+         */
+        QList<T> values() const;
+        /**
+         * Count of items.
+         * @return count
+         */
+        int size() const;
+        /**
+         * Is storage empty?
+         * @return state
+         */
+        bool isEmpty() const;
+
+        const_iterator begin() const;
+        const_iterator end() const;
+};
+
+template<typename T>
+typename SlotMap<T>::Handle SlotMap<T>::insert(Identifier key, const T &value) {
+    const auto existing = m_handles.constFind(key);
+    if (existing != m_handles.constEnd()) {
+        m_values[m_slots.at(existing->index).dense] = value;
+        return *existing;
+    }
+
+    int index;
+    if (m_freeSlots.isEmpty()) {
+        index = m_slots.size();
+        m_slots.append(Slot{});
+    } else {
+        index = m_freeSlots.takeLast();
+    }
+
+    m_slots[index].dense = m_values.size();
+    m_values.append(value);
+    m_keys.append(key);
+    m_denseSlots.append(index);
+
+    const Handle handle{index, m_slots.at(index).generation};
+    m_handles.insert(key, handle);
+    return handle;
+}
+
+template<typename T>
+bool SlotMap<T>::remove(Identifier key) {
+    const auto found = m_handles.find(key);
+    if (found == m_handles.end())
+        return false;
+
+    const int index = found->index;
+    m_handles.erase(found);
+
+    const int dense = m_slots.at(index).dense;
+    const int last = m_values.size() - 1;
+    if (dense != last) {
+        m_values[dense] = m_values.at(last);
+        m_keys[dense] = m_keys.at(last);
+        m_denseSlots[dense] = m_denseSlots.at(last);
+        m_slots[m_denseSlots.at(dense)].dense = dense;
+    }
+    m_values.removeLast();
+    m_keys.removeLast();
+    m_denseSlots.removeLast();
+
+    m_slots[index].dense = -1;
+    m_slots[index].generation++;
+    m_freeSlots.append(index);
+    return true;
+}
+
+template<typename T>
+T SlotMap<T>::take(Identifier key) {
+    const T value = this->value(key);
+    this->remove(key);
+    return value;
+}
+
+template<typename T>
+bool SlotMap<T>::contains(Identifier key) const {
+    return m_handles.contains(key);
+}
+
+template<typename T>
+bool SlotMap<T>::contains(const Handle &handle) const {
+    return handle.index >= 0 && handle.index < m_slots.size() &&
+           m_slots.at(handle.index).generation == handle.generation &&
+           m_slots.at(handle.index).dense >= 0;
+}
+
+template<typename T>
+typename SlotMap<T>::Handle SlotMap<T>::handle(Identifier key) const {
+    return m_handles.value(key, Handle{});
+}
+
+template<typename T>
+T SlotMap<T>::value(Identifier key, const T &defaultValue) const {
+    const auto found = m_handles.constFind(key);
+    if (found == m_handles.constEnd())
+        return defaultValue;
+    return m_values.at(m_slots.at(found->index).dense);
+}
+
+template<typename T>
+T SlotMap<T>::value(const Handle &handle, const T &defaultValue) const {
+    if (!this->contains(handle))
+        return defaultValue;
+    return m_values.at(m_slots.at(handle.index).dense);
+}
+
+template<typename T>
+QList<Identifier> SlotMap<T>::keys() const {
+    return m_keys.toList();
+}
+
+template<typename T>
+QList<T> SlotMap<T>::values() const {
+    return m_values.toList();
+}
+
+template<typename T>
+int SlotMap<T>::size() const {
+    return m_values.size();
+}
+
+template<typename T>
+bool SlotMap<T>::isEmpty() const {
+    return m_values.isEmpty();
+}
+
+template<typename T>
+typename SlotMap<T>::const_iterator SlotMap<T>::begin() const {
+    return m_values.constBegin();
+}
+
+template<typename T>
+typename SlotMap<T>::const_iterator SlotMap<T>::end() const {
+    return m_values.constEnd();
+}
+
+#endif // SLOTMAP_H
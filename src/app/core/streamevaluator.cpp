@@ -0,0 +1,156 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#include "streamevaluator.h"
+
+#include <QStringList>
+#include "blockmanager.h"
+
+StreamEvaluator::StreamEvaluator(const BlockManager* manager) : m_manager{manager}, m_batch{manager} {}
+
+bool StreamEvaluator::parseRow(const QString &line, int row) {
+    const QStringList fields = line.split(StreamEvaluator::s_separator);
+    if (fields.length() != m_ports.length()) {
+        m_error = QString("Row %1: expected %2 fields, got %3.")
+                .arg(m_rows + row + 1).arg(m_ports.length()).arg(fields.length());
+        return false;
+    }
+
+    for (int i = 0; i < fields.length(); i++) {
+        BlockPort* port = m_ports.at(i);
+        const QString field = fields.at(i).trimmed();
+        const Value value = field.isEmpty() ? port->value() : Type::parse(port->type(), field);
+        if (!value.isValid()) {
+            m_error = QString("Row %1: invalid value '%2' in field %3.").arg(m_rows + row + 1).arg(field).arg(i + 1);
+            return false;
+        }
+
+        DataColumn* column = m_columns.at(i);
+        const int width = value.length();
+        if (row == 0)
+            column->reset(width, BatchEvaluator::s_chunkRows);
+        else if (column->width() != width) {
+            m_error = QString("Row %1: vector in field %2 changed its size.").arg(m_rows + row + 1).arg(i + 1);
+            return false;
+        }
+        column->setValue(row, value);
+    }
+    return true;
+}
+
+void StreamEvaluator::flushChunk(QTextStream &output, int rows) {
+    m_batch.evaluateChunk(rows);
+
+    for (int row = 0; row < rows; row++) {
+        for (int i = 0; i < m_outputs.length(); i++) {
+            if (i > 0)
+                output << StreamEvaluator::s_separator;
+            // all digits, rows may be fed to another scheme
+            output << Type::format(m_batch.outputColumn(m_outputs.at(i)).value(row), 17);
+        }
+        output << '\n';
+    }
+    output.flush();
+    m_rows += rows;
+}
+
+void StreamEvaluator::setVariableInputs(const QList<int> &inputs) {
+    m_variables = inputs;
+}
+
+void StreamEvaluator::setObservedOutputs(const QList<int> &outputs) {
+    m_observed = outputs;
+}
+
+bool StreamEvaluator::run(QIODevice* input, QIODevice* output) {
+    m_rows = 0;
+    m_error.clear();
+    m_ports.clear();
+    m_columns.clear();
+    m_outputs.clear();
+
+    if (!m_batch.prepare()) {
+        m_error = "Scheme contains cycle.";
+        return false;
+    }
+
+    const EvaluationPlan &plan = m_manager->plan();
+    if (m_variables.isEmpty())
+        m_ports = plan.freeInputs();
+    for (int index: m_variables) {
+        if (index < 0 || index >= plan.freeInputs().length()) {
+            m_error = QString("Unknown input %1.").arg(index + 1);
+            return false;
+        }
+        m_ports.append(plan.freeInputs().at(index));
+    }
+    for (auto port: m_ports)
+        m_columns.append(m_batch.inputColumn(port));
+
+    // outputs are numbered among unconnected blocks in plan order, same as default outputs of optimizer
+    QList<Identifier> outputs;
+    for (Identifier blockId: plan.order()) {
+        if (!m_manager->block(blockId)->outputPort()->isConnected())
+            outputs.append(blockId);
+    }
+    // columns follow order of selection, repeated output is written repeatedly
+    for (int index: m_observed) {
+        if (index < 0 || index >= outputs.length()) {
+            m_error = QString("Unknown output %1.").arg(index + 1);
+            return false;
+        }
+        m_outputs.append(outputs.at(index));
+    }
+    if (m_observed.isEmpty())
+        m_outputs = outputs;
+    m_batch.setObserved(m_observed.isEmpty() ? QSet<Identifier>{} : m_outputs.toSet());
+
+    QTextStream in{input};
+    QTextStream out{output};
+    int buffered = 0;
+    QString line;
+
+    // rows are read line by line into fixed chunk, so memory does not grow with length of input
+    while (in.readLineInto(&line)) {
+        if (line.trimmed().isEmpty())
+            continue;
+        if (!this->parseRow(line, buffered))
+            return false;
+
+        buffered++;
+        if (buffered == BatchEvaluator::s_chunkRows) {
+            this->flushChunk(out, buffered);
+            buffered = 0;
+        }
+    }
+
+    if (buffered > 0)
+        this->flushChunk(out, buffered);
+    return true;
+}
+
+const QList<BlockPort*> &StreamEvaluator::inputPorts() const {
+    return m_ports;
+}
+
+const QList<Identifier> &StreamEvaluator::outputBlocks() const {
+    return m_outputs;
+}
+
+qint64 StreamEvaluator::rows() const {
+    return m_rows;
+}
+
+QString StreamEvaluator::report() {
+    return m_batch.optimizer().report();
+}
+
+const QString &StreamEvaluator::error() const {
+    return m_error;
+}
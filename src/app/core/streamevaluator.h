@@ -0,0 +1,112 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#ifndef STREAMEVALUATOR_H
+#define STREAMEVALUATOR_H
+
+#include <QIODevice>
+#include <QList>
+#include <QString>
+#include <QTextStream>
+#include "base.h"
+#include "batchevaluator.h"
+
+class BlockManager;
+class BlockPort;
+
+/**
+ * Evaluates scheme over stream of text rows, only one chunk of rows is held in memory.
+ * Input row contains one field per variable input port separated by ';', empty field takes value from scheme.
+ * Output row contains one field per block with unconnected output in order of evaluation.
+ */
+class StreamEvaluator {
+    public:
+        /**
+         * Separator of fields in row.
+         */
+        static constexpr char s_separator = ';';
+
+    private:
+        const BlockManager* m_manager;
+        BatchEvaluator m_batch;
+        QList<BlockPort*> m_ports;
+        QList<DataColumn*> m_columns;
+        QList<Identifier> m_outputs;
+        QList<int> m_variables;
+        QList<int> m_observed;
+        qint64 m_rows = 0;
+        QString m_error;
+
+        /**
+         * Parses one row into chunk columns.
+         * @param line text of row
+         * @param row index of row in chunk
+         * @return false on malformed row
+         */
+        bool parseRow(const QString &line, int row);
+        /**
+         * Evaluates buffered chunk and writes its output rows.
+         * @param output output stream
+         * @param rows count of buffered rows
+         */
+        void flushChunk(QTextStream &output, int rows);
+
+    public:
+        /**
+         * Creates evaluator over scheme in manager.
+         * @param manager manager with scheme
+         */
+        explicit StreamEvaluator(const BlockManager* manager);
+
+        /**
+         * Restricts input row to selected free ports, other ports keep their value from scheme and are folded.
+         * @param inputs indices into free input ports, empty for all
+         */
+        void setVariableInputs(const QList<int> &inputs);
+        /**
+         * Restricts output row to selected results, blocks not needed for them are not evaluated.
+         * @param outputs indices into default output row in order of output columns, empty for all
+         */
+        void setObservedOutputs(const QList<int> &outputs);
+        /**
+         * Reads rows until end of input and writes results after every chunk.
+         * @param input readable device
+         * @param output writable device
+         * @return false if scheme is cyclic, selected port or output is unknown or some row is malformed
+         */
+        bool run(QIODevice* input, QIODevice* output);
+
+        /**
+         * Ordered ports, which are filled from fields of input row.
+         * @return free input ports
+         */
+        const QList<BlockPort*> &inputPorts() const;
+        /**
+         * Ordered blocks, whose results form output row.
+         * @return block identifiers
+         */
+        const QList<Identifier> &outputBlocks() const;
+        /**
+         * Count of rows processed by last run.
+         * @return rows
+         */
+        qint64 rows() const;
+        /**
+         * Summary of optimization of scheme from last run.
+         * @return report
+         */
+        QString report();
+        /**
+         * Description of failure of last run.
+         * @return error message, empty on success
+         */
+        const QString &error() const;
+};
+
+#endif // STREAMEVALUATOR_H
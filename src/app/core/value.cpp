@@ -0,0 +1,98 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#include "value.h"
+
+#include <algorithm>
+
+Value::Value(double scalar) : m_tag{Scalar}, m_length{1} {
+    m_inline[0] = scalar;
+}
+
+Value Value::vector(int length) {
+    Value value;
+    value.m_tag = Vector;
+    value.m_length = length;
+    if (length > Value::s_inlineLength)
+        value.m_shared.fill(0., length);
+    return value;
+}
+
+Value Value::vector(const double* data, int length) {
+    Value value = Value::vector(length);
+    std::copy(data, data + length, value.data());
+    return value;
+}
+
+Value Value::fromVariant(const QVariant &variant) {
+    if (variant.isNull() || !variant.isValid())
+        return Value{};
+    if (variant.type() != QVariant::List)
+        return Value{variant.toDouble()};
+
+    const QList<QVariant> items = variant.toList();
+    Value value = Value::vector(items.length());
+    double* data = value.data();
+    for (int i = 0; i < items.length(); i++)
+        data[i] = items.at(i).toDouble();
+    return value;
+}
+
+QVariant Value::toVariant() const {
+    if (m_tag == Invalid)
+        return QVariant{};
+    if (m_tag == Scalar)
+        return QVariant(m_inline[0]);
+
+    QList<QVariant> items;
+    items.reserve(m_length);
+    for (int i = 0; i < m_length; i++)
+        items.append(QVariant(this->data()[i]));
+    return QVariant(items);
+}
+
+bool Value::isValid() const {
+    return m_tag != Invalid;
+}
+
+bool Value::isVector() const {
+    return m_tag == Vector;
+}
+
+double Value::toDouble() const {
+    return (m_length > 0) ? this->data()[0] : 0.;
+}
+
+int Value::length() const {
+    return m_length;
+}
+
+const double* Value::data() const {
+    return (m_length > Value::s_inlineLength) ? m_shared.constData() : m_inline;
+}
+
+double* Value::data() {
+    return (m_length > Value::s_inlineLength) ? m_shared.data() : m_inline;
+}
+
+bool Value::operator==(const Value &other) const {
+    return m_tag == other.m_tag && m_length == other.m_length &&
+           std::equal(this->data(), this->data() + m_length, other.data());
+}
+
+bool Value::operator!=(const Value &other) const {
+    return !(*this == other);
+}
+
+QDataStream &operator<<(QDataStream &stream, const Value &value) {
+    stream << static_cast<quint8>(value.m_tag) << value.m_length;
+    for (int i = 0; i < value.m_length; i++)
+        stream << value.data()[i];
+    return stream;
+}
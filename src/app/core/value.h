@@ -0,0 +1,113 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#ifndef VALUE_H
+#define VALUE_H
+
+#include <QDataStream>
+#include <QVariant>
+#include <QVector>
+
+/**
+ * Value of port, either scalar or vector of doubles.
+ * Scalars and short vectors are stored inline, longer vectors in implicitly shared buffer.
+ */
+class Value {
+    public:
+        /**
+         * Maximal length of vector stored without heap allocation.
+         */
+        static constexpr int s_inlineLength = 4;
+
+    private:
+        enum Tag : quint8 {
+            Invalid,
+            Scalar,
+            Vector
+        };
+
+        Tag m_tag = Invalid;
+        int m_length = 0;
+        double m_inline[s_inlineLength] = {};
+        QVector<double> m_shared;
+
+    public:
+        /**
+         * Creates invalid value.
+         */
+        Value() = default;
+        /**
+         * Creates scalar value.
+         * @param scalar number
+         */
+        explicit Value(double scalar);
+
+        /**
+         * Creates vector of zeros.
+         * @param length count of items
+         * @return vector value
+         */
+        static Value vector(int length);
+        /**
+         * Creates vector from array.
+         * @param data first item
+         * @param length count of items
+         * @return vector value
+         */
+        static Value vector(const double* data, int length);
+        /**
+         * Converts number or list of numbers, e.g. from json.
+         * @param variant number, list or null
+         * @return value, invalid for null
+         */
+        static Value fromVariant(const QVariant &variant);
+        /**
+         * Converts value to number or list of numbers.
+         * @return variant, null for invalid value
+         */
+        QVariant toVariant() const;
+
+        /**
+         * Is value set?
+         * @return state
+         */
+        bool isValid() const;
+        /**
+         * Is value vector?
+         * @return state
+         */
+        bool isVector() const;
+        /**
+         * Scalar number, first item for vector.
+         * @return number, zero for invalid value
+         */
+        double toDouble() const;
+        /**
+         * Count of numbers, 1 for scalar.
+         * @return length
+         */
+        int length() const;
+        /**
+         * Numbers of value.
+         * @return pointer to first number
+         */
+        const double* data() const;
+        /**
+         * Numbers of value, shared buffer is detached.
+         * @return pointer to first number
+         */
+        double* data();
+
+        bool operator==(const Value &other) const;
+        bool operator!=(const Value &other) const;
+
+        friend QDataStream &operator<<(QDataStream &stream, const Value &value);
+};
+
+#endif // VALUE_H
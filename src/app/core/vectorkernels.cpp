@@ -0,0 +1,215 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#include "vectorkernels.h"
+
+#include <QtMath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VECTORKERNELS_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+    /**
+     * Implementations of kernels for one instruction set.
+     */
+    struct KernelTable {
+        const char* name;
+        double (* dot)(const double*, const double*, int);
+        void (* add)(const double*, const double*, double*, int);
+        void (* sub)(const double*, const double*, double*, int);
+        void (* mul)(const double*, const double*, double*, int);
+        void (* scale)(const double*, double, double*, int);
+    };
+
+    double genericDot(const double* first, const double* second, int length) {
+        double sum = 0;
+        for (int i = 0; i < length; i++)
+            sum += first[i] * second[i];
+        return sum;
+    }
+
+    void genericAdd(const double* first, const double* second, double* target, int length) {
+        for (int i = 0; i < length; i++)
+            target[i] = first[i] + second[i];
+    }
+
+    void genericSub(const double* first, const double* second, double* target, int length) {
+        for (int i = 0; i < length; i++)
+            target[i] = first[i] - second[i];
+    }
+
+    void genericMul(const double* first, const double* second, double* target, int length) {
+        for (int i = 0; i < length; i++)
+            target[i] = first[i] * second[i];
+    }
+
+    void genericScale(const double* values, double factor, double* target, int length) {
+        for (int i = 0; i < length; i++)
+            target[i] = values[i] * factor;
+    }
+
+#ifdef VECTORKERNELS_X86
+    __attribute__((target("sse2")))
+    double sseDot(const double* first, const double* second, int length) {
+        __m128d low = _mm_setzero_pd();
+        __m128d high = _mm_setzero_pd();
+        int i = 0;
+        for (; i + 4 <= length; i += 4) {
+            low = _mm_add_pd(low, _mm_mul_pd(_mm_loadu_pd(first + i), _mm_loadu_pd(second + i)));
+            high = _mm_add_pd(high, _mm_mul_pd(_mm_loadu_pd(first + i + 2), _mm_loadu_pd(second + i + 2)));
+        }
+        double lanes[2];
+        _mm_storeu_pd(lanes, _mm_add_pd(low, high));
+        double sum = lanes[0] + lanes[1];
+        for (; i < length; i++)
+            sum += first[i] * second[i];
+        return sum;
+    }
+
+    __attribute__((target("sse2")))
+    void sseAdd(const double* first, const double* second, double* target, int length) {
+        int i = 0;
+        for (; i + 2 <= length; i += 2)
+            _mm_storeu_pd(target + i, _mm_add_pd(_mm_loadu_pd(first + i), _mm_loadu_pd(second + i)));
+        for (; i < length; i++)
+            target[i] = first[i] + second[i];
+    }
+
+    __attribute__((target("sse2")))
+    void sseSub(const double* first, const double* second, double* target, int length) {
+        int i = 0;
+        for (; i + 2 <= length; i += 2)
+            _mm_storeu_pd(target + i, _mm_sub_pd(_mm_loadu_pd(first + i), _mm_loadu_pd(second + i)));
+        for (; i < length; i++)
+            target[i] = first[i] - second[i];
+    }
+
+    __attribute__((target("sse2")))
+    void sseMul(const double* first, const double* second, double* target, int length) {
+        int i = 0;
+        for (; i + 2 <= length; i += 2)
+            _mm_storeu_pd(target + i, _mm_mul_pd(_mm_loadu_pd(first + i), _mm_loadu_pd(second + i)));
+        for (; i < length; i++)
+            target[i] = first[i] * second[i];
+    }
+
+    __attribute__((target("sse2")))
+    void sseScale(const double* values, double factor, double* target, int length) {
+        const __m128d factors = _mm_set1_pd(factor);
+        int i = 0;
+        for (; i + 2 <= length; i += 2)
+            _mm_storeu_pd(target + i, _mm_mul_pd(_mm_loadu_pd(values + i), factors));
+        for (; i < length; i++)
+            target[i] = values[i] * factor;
+    }
+
+    __attribute__((target("avx2")))
+    double avxDot(const double* first, const double* second, int length) {
+        __m256d low = _mm256_setzero_pd();
+        __m256d high = _mm256_setzero_pd();
+        int i = 0;
+        for (; i + 8 <= length; i += 8) {
+            low = _mm256_add_pd(low, _mm256_mul_pd(_mm256_loadu_pd(first + i), _mm256_loadu_pd(second + i)));
+            high = _mm256_add_pd(high, _mm256_mul_pd(_mm256_loadu_pd(first + i + 4),
+                                                     _mm256_loadu_pd(second + i + 4)));
+        }
+        double lanes[4];
+        _mm256_storeu_pd(lanes, _mm256_add_pd(low, high));
+        double sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        for (; i < length; i++)
+            sum += first[i] * second[i];
+        return sum;
+    }
+
+    __attribute__((target("avx2")))
+    void avxAdd(const double* first, const double* second, double* target, int length) {
+        int i = 0;
+        for (; i + 4 <= length; i += 4)
+            _mm256_storeu_pd(target + i, _mm256_add_pd(_mm256_loadu_pd(first + i), _mm256_loadu_pd(second + i)));
+        for (; i < length; i++)
+            target[i] = first[i] + second[i];
+    }
+
+    __attribute__((target("avx2")))
+    void avxSub(const double* first, const double* second, double* target, int length) {
+        int i = 0;
+        for (; i + 4 <= length; i += 4)
+            _mm256_storeu_pd(target + i, _mm256_sub_pd(_mm256_loadu_pd(first + i), _mm256_loadu_pd(second + i)));
+        for (; i < length; i++)
+            target[i] = first[i] - second[i];
+    }
+
+    __attribute__((target("avx2")))
+    void avxMul(const double* first, const double* second, double* target, int length) {
+        int i = 0;
+        for (; i + 4 <= length; i += 4)
+            _mm256_storeu_pd(target + i, _mm256_mul_pd(_mm256_loadu_pd(first + i), _mm256_loadu_pd(second + i)));
+        for (; i < length; i++)
+            target[i] = first[i] * second[i];
+    }
+
+    __attribute__((target("avx2")))
+    void avxScale(const double* values, double factor, double* target, int length) {
+        const __m256d factors = _mm256_set1_pd(factor);
+        int i = 0;
+        for (; i + 4 <= length; i += 4)
+            _mm256_storeu_pd(target + i, _mm256_mul_pd(_mm256_loadu_pd(values + i), factors));
+        for (; i < length; i++)
+            target[i] = values[i] * factor;
+    }
+#endif
+
+    /**
+     * Selects kernels for running CPU, detection runs only on first call.
+     * @return table of kernels
+     */
+    const KernelTable &kernels() {
+        static const KernelTable table = []() {
+#ifdef VECTORKERNELS_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2"))
+                return KernelTable{"avx2", avxDot, avxAdd, avxSub, avxMul, avxScale};
+            if (__builtin_cpu_supports("sse2"))
+                return KernelTable{"sse2", sseDot, sseAdd, sseSub, sseMul, sseScale};
+#endif
+            return KernelTable{"generic", genericDot, genericAdd, genericSub, genericMul, genericScale};
+        }();
+        return table;
+    }
+}
+
+double VectorKernels::dot(const double* first, const double* second, int length) {
+    return kernels().dot(first, second, length);
+}
+
+double VectorKernels::magnitude(const double* values, int length) {
+    return qSqrt(kernels().dot(values, values, length));
+}
+
+void VectorKernels::add(const double* first, const double* second, double* target, int length) {
+    kernels().add(first, second, target, length);
+}
+
+void VectorKernels::sub(const double* first, const double* second, double* target, int length) {
+    kernels().sub(first, second, target, length);
+}
+
+void VectorKernels::mul(const double* first, const double* second, double* target, int length) {
+    kernels().mul(first, second, target, length);
+}
+
+void VectorKernels::scale(const double* values, double factor, double* target, int length) {
+    kernels().scale(values, factor, target, length);
+}
+
+QString VectorKernels::instructionSet() {
+    return kernels().name;
+}
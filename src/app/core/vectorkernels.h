@@ -0,0 +1,76 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#ifndef VECTORKERNELS_H
+#define VECTORKERNELS_H
+
+#include <QString>
+
+/**
+ * Arithmetic over contiguous arrays of doubles.
+ * Implementation is chosen once at runtime by features of CPU (AVX2, SSE2 or plain loops).
+ */
+class VectorKernels {
+    public:
+        /**
+         * Dot product of two arrays.
+         * @param first first array
+         * @param second second array
+         * @param length count of items
+         * @return sum of products
+         */
+        static double dot(const double* first, const double* second, int length);
+        /**
+         * Euclidean norm of array.
+         * @param values array
+         * @param length count of items
+         * @return magnitude
+         */
+        static double magnitude(const double* values, int length);
+        /**
+         * Elementwise sum, target may alias operand.
+         * @param first first array
+         * @param second second array
+         * @param target result array
+         * @param length count of items
+         */
+        static void add(const double* first, const double* second, double* target, int length);
+        /**
+         * Elementwise difference, target may alias operand.
+         * @param first first array
+         * @param second second array
+         * @param target result array
+         * @param length count of items
+         */
+        static void sub(const double* first, const double* second, double* target, int length);
+        /**
+         * Elementwise product, target may alias operand.
+         * @param first first array
+         * @param second second array
+         * @param target result array
+         * @param length count of items
+         */
+        static void mul(const double* first, const double* second, double* target, int length);
+        /**
+         * Multiplies array by number, target may alias operand.
+         * @param values array
+         * @param factor number
+         * @param target result array
+         * @param length count of items
+         */
+        static void scale(const double* values, double factor, double* target, int length);
+
+        /**
+         * Name of used instruction set.
+         * @return avx2, sse2 or generic
+         */
+        static QString instructionSet();
+};
+
+#endif // VECTORKERNELS_H
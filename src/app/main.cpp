@@ -9,19 +9,119 @@
 
 #include "mainwindow.h"
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QFile>
 #include <QFontDatabase>
 #include <QGraphicsScene>
 #include <QGraphicsView>
+#include <QJsonDocument>
+#include <QScopedPointer>
+#include <QTextStream>
+#include <cstdio>
 #include "ui/window/graphicsview.h"
 #include <app/core/blocks/blocks.h>
+#include <app/core/schemeio.h>
+#include <app/core/streamevaluator.h>
 
-int main(int argc, char* argv[]) {
-    QApplication a(argc, argv);
+/**
+ * Evaluates scheme over rows of input without opening window.
+ * @param schemePath path to saved scheme
+ * @param inputPath path to input rows, stdin if empty
+ * @param outputPath path for output rows, stdout if empty
+ * @param parser parsed command line with selected inputs and outputs
+ * @return process exit code
+ */
+static int streamScheme(const QString &schemePath, const QString &inputPath, const QString &outputPath,
+                        const QCommandLineParser &parser) {
+    QTextStream err{stderr};
 
-    QFontDatabase::addApplicationFont(":/res/font/Montserrat-Light.ttf");
-    QFontDatabase::addApplicationFont(":/res/font/Montserrat-Medium.ttf");
-    QFontDatabase::addApplicationFont(":/res/font/Roboto-Light.ttf");
+    QFile schemeFile{schemePath};
+    if (!schemeFile.open(QIODevice::ReadOnly)) {
+        err << "Scheme file could not be open." << endl;
+        return 1;
+    }
+    QJsonDocument doc = QJsonDocument::fromJson(schemeFile.readAll());
+    if (doc.isNull()) {
+        err << "Json parse error" << endl;
+        return 1;
+    }
 
+    BlockManager manager;
+    SchemeIO schemeIO{&manager};
+    bool loaded = true;
+    QObject::connect(&schemeIO, &SchemeIO::error, [&err, &loaded](const QString &msg) {
+        err << msg << endl;
+        loaded = false;
+    });
+    schemeIO.loadFromJson(doc.object(), nullptr);
+    if (!loaded)
+        return 1;
+
+    QFile input{inputPath};
+    QFile output{outputPath};
+    const bool inputOpen = inputPath.isEmpty() ? input.open(stdin, QIODevice::ReadOnly)
+                                               : input.open(QIODevice::ReadOnly);
+    const bool outputOpen = outputPath.isEmpty() ? output.open(stdout, QIODevice::WriteOnly)
+                                                 : output.open(QIODevice::WriteOnly);
+    if (!inputOpen || !outputOpen) {
+        err << "File could not be open." << endl;
+        return 1;
+    }
+
+    // selections are 1-based on command line
+    const auto indices = [&parser](const QString &option) {
+        QList<int> result;
+        for (const QString &item: parser.value(option).split(',', QString::SkipEmptyParts))
+            result.append(item.toInt() - 1);
+        return result;
+    };
+
+    static const QMap<QString, BlockProfile::Key> profileKeys{
+            {"time",        BlockProfile::Time},
+            {"calls",       BlockProfile::Calls},
+            {"allocations", BlockProfile::Allocations},
+    };
+    if (parser.isSet("profile") && !profileKeys.contains(parser.value("profile"))) {
+        err << "Unknown profile key." << endl;
+        return 1;
+    }
+#ifndef BLOCK_PROFILE_ALLOCATIONS
+    if (parser.value("profile") == "allocations")
+        err << "Allocations are counted only in build with BLOCK_PROFILE_ALLOCATIONS." << endl;
+#endif
+    manager.setProfiling(parser.isSet("profile"));
+
+    StreamEvaluator evaluator{&manager};
+    evaluator.setVariableInputs(indices("inputs"));
+    evaluator.setObservedOutputs(indices("outputs"));
+    if (!evaluator.run(&input, &output)) {
+        err << evaluator.error() << endl;
+        return 1;
+    }
+    if (parser.isSet("report"))
+        err << evaluator.report() << flush;
+    if (parser.isSet("profile"))
+        err << manager.profileReport(profileKeys.value(parser.value("profile"))) << flush;
+    return 0;
+}
+
+/**
+ * Is evaluation without window requested? Decided before application is created, so no gui is initialized.
+ * @param argc count of arguments
+ * @param argv arguments
+ * @return state
+ */
+static bool streamRequested(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (qstrcmp(argv[i], "--stream") == 0 || qstrncmp(argv[i], "--stream=", 9) == 0)
+            return true;
+    }
+    return false;
+}
+
+int main(int argc, char* argv[]) {
+    QScopedPointer<QCoreApplication> a{streamRequested(argc, argv) ? new QCoreApplication(argc, argv)
+                                                                   : new QApplication(argc, argv)};
 
     Block::registerBlock<AddBlock>(2);
     Block::registerBlock<SubBlock>(2);
@@ -31,6 +131,33 @@ int main(int argc, char* argv[]) {
     Block::registerBlock<VectMagBlock>(1);
     Block::registerBlock<VectInitBlock>(2);
 
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    const QCommandLineOption streamOption{"stream", "Evaluate <scheme> over rows of input without window.", "scheme"};
+    const QCommandLineOption inputOption{"input", "Read input rows from <file> instead of stdin.", "file"};
+    const QCommandLineOption outputOption{"output", "Write output rows to <file> instead of stdout.", "file"};
+    const QCommandLineOption inputsOption{"inputs", "Read only free input ports <list> from rows, others are constant.", "list"};
+    const QCommandLineOption outputsOption{"outputs", "Write only results <list>, unneeded blocks are skipped.", "list"};
+    const QCommandLineOption reportOption{"report", "Print folded and removed blocks."};
+    const QCommandLineOption profileOption{"profile", "Print cost of blocks sorted by <key>: time, calls or allocations.", "key"};
+    parser.addOption(streamOption);
+    parser.addOption(inputOption);
+    parser.addOption(outputOption);
+    parser.addOption(inputsOption);
+    parser.addOption(outputsOption);
+    parser.addOption(reportOption);
+    parser.addOption(profileOption);
+    parser.process(*a);
+
+    if (parser.isSet(streamOption)) {
+        Block::setHeadless(true);
+        return streamScheme(parser.value(streamOption), parser.value(inputOption), parser.value(outputOption), parser);
+    }
+
+    QFontDatabase::addApplicationFont(":/res/font/Montserrat-Light.ttf");
+    QFontDatabase::addApplicationFont(":/res/font/Montserrat-Medium.ttf");
+    QFontDatabase::addApplicationFont(":/res/font/Roboto-Light.ttf");
+
     auto scene = new QGraphicsScene;
 
     auto widget = new AppWindow;
@@ -45,5 +172,5 @@ int main(int argc, char* argv[]) {
     view->setWindowTitle("Block Editor");
     view->show();
 
-    return a.exec();
+    return a->exec();
 }
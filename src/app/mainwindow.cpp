@@ -17,8 +17,42 @@
 #include <QGraphicsScene>
 #include <app/ui/control/textedit.h>
 #include <QFileDialog>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QSet>
 #include <app/ui/window/graphicsview.h>
 
+/**
+ * Makes valid C++ identifier from file name, which is not keyword nor reserved name.
+ * @param name file name without suffix
+ * @return identifier matching [A-Za-z_][A-Za-z0-9_]*
+ */
+static QString cppIdentifier(const QString &name) {
+    static const QSet<QString> keywords{
+            "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break", "case",
+            "catch", "char", "char16_t", "char32_t", "class", "compl", "const", "constexpr", "const_cast",
+            "continue", "decltype", "default", "delete", "do", "double", "dynamic_cast", "else", "enum",
+            "explicit", "export", "extern", "false", "float", "for", "friend", "goto", "if", "inline", "int",
+            "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq", "nullptr", "operator", "or",
+            "or_eq", "private", "protected", "public", "register", "reinterpret_cast", "return", "short",
+            "signed", "sizeof", "static", "static_assert", "static_cast", "struct", "switch", "template", "this",
+            "thread_local", "throw", "true", "try", "typedef", "typeid", "typename", "union", "unsigned",
+            "using", "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq",
+    };
+
+    QString identifier = name;
+    identifier.replace(QRegularExpression("[^A-Za-z0-9_]"), "_");
+    // double and leading underscores are reserved for implementation
+    identifier.replace(QRegularExpression("_{2,}"), "_");
+    if (identifier.isEmpty() || identifier.at(0).isDigit())
+        identifier.prepend("scheme_");
+    else if (identifier.at(0) == '_')
+        identifier.prepend("scheme");
+    if (keywords.contains(identifier))
+        identifier.append("_");
+    return identifier;
+}
+
 AppWindow::AppWindow(QGraphicsWidget* parent) : QGraphicsWidget{parent} {
     m_blockSelection = new BlocksSelection{this};
     m_blockSelection->setMaximumWidth(195);
@@ -35,7 +69,10 @@ AppWindow::AppWindow(QGraphicsWidget* parent) : QGraphicsWidget{parent} {
 
     connect(m_toolbar, &ToolBar::evaluate, m_blockCanvas, &BlockCanvas::evaluate);
     connect(m_toolbar, &ToolBar::debug, m_blockCanvas, &BlockCanvas::debug);
+    connect(m_toolbar, &ToolBar::debugBack, m_blockCanvas, &BlockCanvas::debugStepBack);
     connect(m_toolbar, &ToolBar::stop, m_blockCanvas, &BlockCanvas::stopDebug);
+    connect(m_toolbar, &ToolBar::stop, m_blockCanvas, &BlockCanvas::cancelEvaluation);
+    connect(m_blockCanvas, &BlockCanvas::evaluationProgress, m_toolbar, &ToolBar::setProgress);
     connect(m_blockCanvas, &BlockCanvas::debugStateChanged,
             m_toolbar, &ToolBar::setDebugIconVisiblity);
     connect(m_blockCanvas, &BlockCanvas::error, [this](const QString &msg) {
@@ -54,6 +91,17 @@ AppWindow::AppWindow(QGraphicsWidget* parent) : QGraphicsWidget{parent} {
     connect(m_toolbar, &ToolBar::saveFile, this, &AppWindow::schemeSave);
     connect(m_toolbar, &ToolBar::newFile, this, &AppWindow::schemeNew);
     connect(m_toolbar, &ToolBar::saveAsFile, this, &AppWindow::schemeSaveAs);
+    connect(m_toolbar, &ToolBar::exportFile, this, &AppWindow::schemeExport);
+    connect(m_toolbar, &ToolBar::profilingChanged, this, &AppWindow::setProfileKey);
+    connect(m_toolbar, &ToolBar::report, this, &AppWindow::showReport);
+    connect(m_toolbar, &ToolBar::autoEvaluateChanged, m_blockCanvas, &BlockCanvas::setAutoEvaluate);
+    connect(m_toolbar, &ToolBar::engineChanged, [this](int engine) {
+        m_blockCanvas->setEngine(static_cast<BlockCanvas::Engine>(engine));
+    });
+    connect(m_toolbar, &ToolBar::cacheLimitChanged, [this](int entries) {
+        m_blockCanvas->manager()->setCacheLimit(entries);
+        m_cacheLimit = entries;
+    });
 
     connect(m_blockCanvas, &BlockCanvas::blockAdded, [this]() { this->setSaved(false); });
     connect(m_blockCanvas, &BlockCanvas::joinAdded, [this]() { this->setSaved(false); });
@@ -218,3 +266,50 @@ void AppWindow::schemeNew() {
     this->setSaved(true);
     this->setCurrentPath("");
 }
+
+void AppWindow::schemeExport() {
+    const QString filePath = QFileDialog::getSaveFileName(
+            nullptr,
+            tr("Export file"),
+            QString(),
+            QString("%1 (*.h);;All Files (*.*)").arg(tr("C++ headers")));
+    if (filePath.isEmpty())
+        return;
+
+    const QString source = m_schemeIO->exportToCpp(cppIdentifier(QFileInfo(filePath).baseName()));
+    if (source.isEmpty()) {
+        emit this->error(tr("Scheme could not be exported."));
+        return;
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        emit this->error(tr("File could not be open."));
+        return;
+    }
+
+    file.write(source.toUtf8());
+}
+
+void AppWindow::setProfileKey(int key) {
+    m_profileKey = key;
+    m_blockCanvas->setProfiling(key >= 0);
+}
+
+void AppWindow::showReport() {
+    if (m_profileKey < 0 && m_cacheLimit == 0) {
+        emit this->error(tr("Profiling and cache are off."));
+        return;
+    }
+
+    const BlockManager* manager = m_blockCanvas->manager();
+    QString report;
+    if (m_profileKey >= 0)
+        report += manager->profileReport(static_cast<BlockProfile::Key>(m_profileKey));
+    if (m_cacheLimit > 0)
+        report += tr("cache: %1 hits, %2 misses\n").arg(manager->cacheHits()).arg(manager->cacheMisses());
+    QMessageBox::information(
+            nullptr,
+            tr("Report"),
+            QString("<pre>%1</pre>").arg(report.toHtmlEscaped()));
+}
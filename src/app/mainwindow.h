@@ -33,6 +33,8 @@ class AppWindow : public QGraphicsWidget {
         QString m_currentPath = "";
         SchemeIO* m_schemeIO;
         bool m_saved = true;
+        int m_profileKey = -1;
+        int m_cacheLimit = 0;
 
     public:
         explicit AppWindow(QGraphicsWidget* parent = nullptr);
@@ -94,6 +96,20 @@ class AppWindow : public QGraphicsWidget {
          * Creates empty scheme.
          */
         void schemeNew();
+        /**
+         * Export scheme as C++ header.
+         */
+        void schemeExport();
+
+        /**
+         * Switches profiling of canvas.
+         * @param key sort key of report, -1 disables profiling
+         */
+        void setProfileKey(int key);
+        /**
+         * Shows report of profiled blocks sorted by current key and counters of cache.
+         */
+        void showReport();
 
     signals:
         /**
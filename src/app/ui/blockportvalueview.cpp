@@ -31,23 +31,12 @@ BlockPortValueView::BlockPortValueView(BlockPort* data, Type::TypeE type, QGraph
     this->resizeWithText();
     connect(m_input, &TextEditWithFixedText::geometryChanged,
             this, &BlockPortValueView::resizeWithText);
+    connect(m_input, &TextEditWithFixedText::textChanged,
+            this, &BlockPortValueView::propagateToPort);
 }
 
-MappedDataValues BlockPortValueView::value() const {
-    if (!m_input->valid())
-        return MappedDataValues{};
-    if (m_type == Type::Scalar || m_type == Type::Angle)
-        return MappedDataValues{{"value", m_input->toPlainText().toDouble()}};
-    else if (m_type == Type::Vector) {
-        QString raw = m_input->toPlainText();
-        raw = raw.remove("{").remove("}");
-        QList<QVariant> values;
-        for (const auto &singleVal: raw.split(","))
-            values.append(QVariant(singleVal.toDouble()));
-
-        return MappedDataValues{{"value", QVariant(values)}};
-    } else
-        Q_ASSERT_X(false, "Parsing", "Unkown type");
+Value BlockPortValueView::value() const {
+    return Type::parse(m_type, m_input->toPlainText());
 }
 
 QString BlockPortValueView::rawValue(bool typed) const {
@@ -56,32 +45,10 @@ QString BlockPortValueView::rawValue(bool typed) const {
     return QString("%1 %2").arg(m_input->fixedToPlainText(), m_input->toPlainText());
 }
 
-void BlockPortValueView::setValue(MappedDataValues v) {
-    if (!v.keys().contains("value")) {
-        m_input->setPlainText("");
-        return;
-    }
-    const QVariant val = v.value("value");
-    QString repr = "{";
-
-    if (val.isNull())
-        repr = "";
-    else if (val.type() == QVariant::Double)
-        repr = QString::number(val.toDouble());
-    else if (val.type() == QVariant::List) {
-        int i = 0;
-        QList<DataValue> values = val.value<QList<DataValue> >();
-        for (const auto &v: values) {
-            repr += QString::number(v.toDouble());
-            if (i + 1 < values.length())
-                repr += ",";
-            i++;
-        }
-        repr += "}";
-    } else
-        Q_ASSERT_X(false, "Repr value", "Unknown type");
-
-    m_input->setPlainText(repr);
+void BlockPortValueView::setValue(const Value &v) {
+    m_settingValue = true;
+    m_input->setPlainText(Type::format(v));
+    m_settingValue = false;
 }
 
 bool BlockPortValueView::valid() const {
@@ -99,3 +66,10 @@ void BlockPortValueView::setEditable(bool v) {
 void BlockPortValueView::resizeWithText() {
     this->resize(m_input->boundingRect().size());
 }
+
+void BlockPortValueView::propagateToPort() {
+    if (m_settingValue || this->portData() == nullptr)
+        return;
+    this->portData()->setValueFromView(this->value());
+    emit this->valueEdited();
+}
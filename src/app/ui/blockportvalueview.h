@@ -24,6 +24,7 @@ class BlockPortValueView : public BlockPortView {
     private:
         TextEditWithFixedText* m_input;
         Type::TypeE m_type;
+        bool m_settingValue = false;
 
     public:
         /**
@@ -38,7 +39,7 @@ class BlockPortValueView : public BlockPortView {
          * Getter for value of port
          * @return value
          */
-        MappedDataValues value() const override;
+        Value value() const override;
         /**
          * Getter for raw value of port, without validation.
          * @param typed should be value typed?
@@ -49,7 +50,7 @@ class BlockPortValueView : public BlockPortView {
          * Sets value to port.
          * @param v value
          */
-        void setValue(MappedDataValues v) override;
+        void setValue(const Value &v) override;
         /**
          * Is port valid?
          * @return state
@@ -63,6 +64,10 @@ class BlockPortValueView : public BlockPortView {
 
     private slots:
         void resizeWithText();
+        /**
+         * Passes value edited by user into core port.
+         */
+        void propagateToPort();
 };
 
 #endif // BLOCKPORTVALUEVIEW_H
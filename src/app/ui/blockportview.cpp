@@ -9,6 +9,8 @@
 
 #include "blockportview.h"
 
+#include <QTimer>
+#include <app/core/blocks/blockport.h>
 
 BlockPortView::BlockPortView(BlockPort* data, QGraphicsItem* parent) : QGraphicsWidget(parent) {
     m_data = data;
@@ -28,6 +30,38 @@ BlockPort* BlockPortView::portData() const {
     return m_data;
 }
 
+bool BlockPortView::shown() const {
+    if (!this->isVisible() || qFuzzyIsNull(this->opacity()))
+        return false;
+
+    const QRectF rect = this->sceneBoundingRect();
+    for (const QGraphicsItem* item = this->parentItem(); item != nullptr; item = item->parentItem()) {
+        if (item->flags() & QGraphicsItem::ItemClipsChildrenToShape)
+            return item->sceneBoundingRect().intersects(rect);
+    }
+    return true;
+}
+
+void BlockPortView::invalidateValue() {
+    m_stale = true;
+    if (this->shown())
+        this->refreshValue();
+}
+
+void BlockPortView::refreshValue() {
+    if (!m_stale || m_data == nullptr)
+        return;
+    m_stale = false;
+    this->setValue(m_data->value());
+}
+
+void BlockPortView::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+    QGraphicsWidget::paint(painter, option, widget);
+    // changing text while painting would relayout scene, so refresh after this frame
+    if (m_stale)
+        QTimer::singleShot(0, this, &BlockPortView::refreshValue);
+}
+
 void BlockPortView::animateHide(bool animate) {
     if (this->opacity() == 0.)
         return;
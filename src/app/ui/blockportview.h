@@ -25,6 +25,7 @@ class BlockPortView : public QGraphicsWidget {
     private:
         QVariantAnimation* m_opacityAnimation;
         BlockPort* m_data;
+        bool m_stale = false;
 
     public:
         /**
@@ -39,12 +40,12 @@ class BlockPortView : public QGraphicsWidget {
          * Getter for value of port.
          * @return value
          */
-        virtual MappedDataValues value() const = 0;
+        virtual Value value() const = 0;
         /**
          * Setter for port value.
          * @param v new value
          */
-        virtual void setValue(MappedDataValues v) = 0;
+        virtual void setValue(const Value &v) = 0;
         /**
          * Getter for value without validation.
          * @param typed flag if values should be type
@@ -62,8 +63,31 @@ class BlockPortView : public QGraphicsWidget {
          * @return
          */
         BlockPort* portData() const;
+        /**
+         * Is view drawn, i.e. visible, not transparent and not clipped away by scroll area?
+         * @return state
+         */
+        bool shown() const;
+        /**
+         * Marks shown value as outdated, refreshes it immediately only if view is shown.
+         * Hidden view is refreshed when it is painted again.
+         */
+        void invalidateValue();
+
+    protected:
+        /**
+         * Refreshes outdated value once view gets painted.
+         * @param painter painter
+         * @param option style option
+         * @param widget widget
+         */
+        void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
 
     public slots:
+        /**
+         * Copies value from port to view, if shown value is outdated.
+         */
+        void refreshValue();
         /**
          * Receiver for animation to hide.
          * @param animate flag
@@ -82,6 +106,12 @@ class BlockPortView : public QGraphicsWidget {
          * @param animate with animation?
          */
         void animatePartialHide(double v, bool animate = true);
+
+    signals:
+        /**
+         * On value changed by user.
+         */
+        void valueEdited();
 };
 
 #endif // BLOCKPORTVIEW_H
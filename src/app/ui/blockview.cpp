@@ -77,15 +77,26 @@ void BlockView::mouseReleaseEvent(QGraphicsSceneMouseEvent* event) {
 
 void BlockView::keyPressEvent(QKeyEvent* event) {
     if (event->key() == Qt::Key_Delete) {
+        QSet<Identifier> blockIds;
+        QSet<Identifier> joinIds;
         for (auto item: this->scene()->selectedItems()) {
             auto blockView = dynamic_cast<BlockView*>(item);
             auto joinView = dynamic_cast<JoinView*>(item);
 
             if (blockView != nullptr)
-                    emit blockView->deleteRequest(blockView->blockData()->id());
+                blockIds.insert(blockView->blockData()->id());
             else if (joinView != nullptr)
-                    emit joinView->deleteRequest(joinView->dataId());
+                joinIds.insert(joinView->dataId());
         }
+        emit this->deleteItemsRequest(blockIds, joinIds);
+    } else if (event->key() == Qt::Key_F9) {
+        for (auto item: this->scene()->selectedItems()) {
+            auto blockView = dynamic_cast<BlockView*>(item);
+            if (blockView != nullptr)
+                blockView->blockData()->setBreakpoint(!blockView->blockData()->breakpoint());
+        }
+    } else if (event->key() == Qt::Key_F4) {
+        emit this->runToRequest(m_data->id());
     }
 
     QGraphicsWidget::keyPressEvent(event);
@@ -125,7 +136,16 @@ void BlockView::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
     painter->setPen(QColor(Qt::transparent));
     if (this->isSelected())
         painter->setBrush(QColor("#0f81bc"));
-    else
+    else if (m_highlighted)
+        painter->setBrush(QColor("#d10000"));
+    else if (m_cost >= 0) {
+        // heatmap goes from background color to orange by relative cost
+        const QColor hot{"#e8730c"};
+        painter->setBrush(QColor::fromRgbF(
+                m_backgroundColor.redF() + (hot.redF() - m_backgroundColor.redF()) * m_cost,
+                m_backgroundColor.greenF() + (hot.greenF() - m_backgroundColor.greenF()) * m_cost,
+                m_backgroundColor.blueF() + (hot.blueF() - m_backgroundColor.blueF()) * m_cost));
+    } else
         painter->setBrush(m_backgroundColor);
     painter->drawRect(blockRect);
 
@@ -158,6 +178,12 @@ void BlockView::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
 
     // draw icon
     m_imageRenderer.render(painter, blockRect);
+
+    if (m_data->breakpoint()) {
+        painter->setPen(QPen(QColor(Qt::white), 1.5));
+        painter->setBrush(QColor("#d10000"));
+        painter->drawEllipse(QPointF{blockRect.left() + 8, blockRect.top() + 8}, 5, 5);
+    }
     painter->restore();
 }
 
@@ -181,11 +207,8 @@ QPixmap BlockView::pixmap() {
     return pixmap;
 }
 
-QList<MappedDataValues> BlockView::values() const {
-    QList<MappedDataValues> inputs;
-    for (auto port: m_data->inputPorts())
-        inputs.append(port->value());
-    return inputs;
+QVector<Value> BlockView::values() const {
+    return m_data->inputValues();
 }
 
 void BlockView::repositionPorts() {
@@ -288,3 +311,15 @@ void BlockView::setBackgroundColor(const QColor &color) {
 void BlockView::setBackgroundSelectionColor(const QColor &color) {
     m_backgroundSelectionColor = color;
 }
+
+void BlockView::setHighlighted(bool v) {
+    if (m_highlighted == v)
+        return;
+    m_highlighted = v;
+    this->update();
+}
+
+void BlockView::setCost(double cost) {
+    m_cost = qMin(cost, 1.);
+    this->update();
+}
@@ -13,6 +13,7 @@
 #include <app/core/identified.h>
 #include <QGraphicsWidget>
 #include <QPointer>
+#include <QSet>
 #include <QSvgRenderer>
 
 class Block;
@@ -34,6 +35,8 @@ class BlockView : public QGraphicsWidget {
         bool m_copyable = true;
         bool m_outputPortVisible = true;
         bool m_inputPortsVisible = true;
+        bool m_highlighted = false;
+        double m_cost = -1;
 
     public:
         /**
@@ -106,7 +109,7 @@ class BlockView : public QGraphicsWidget {
          * Returns values of internal block.
          * @return mapping
          */
-        QList<MappedDataValues> values() const;
+        QVector<Value> values() const;
 
     private slots:
         void repositionPorts();
@@ -150,6 +153,16 @@ class BlockView : public QGraphicsWidget {
          * @param color color
          */
         void setBackgroundSelectionColor(const QColor &color);
+        /**
+         * Sets warning highlight of block, e.g. as part of cycle.
+         * @param v state
+         */
+        void setHighlighted(bool v);
+        /**
+         * Sets relative cost of block for profiler heatmap.
+         * @param cost cost between 0 and 1, negative disables tint
+         */
+        void setCost(double cost);
 
     signals:
         /**
@@ -165,6 +178,17 @@ class BlockView : public QGraphicsWidget {
          * @param blockId unique identifier.
          */
         void deleteRequest(Identifier blockId);
+        /**
+         * Receiver for delete request of selected blocks and joins.
+         * @param blockIds selected blocks
+         * @param joinIds selected joins
+         */
+        void deleteItemsRequest(const QSet<Identifier> &blockIds, const QSet<Identifier> &joinIds);
+        /**
+         * Receiver for request to debug up to block.
+         * @param blockId unique identifier.
+         */
+        void runToRequest(Identifier blockId);
 };
 
 #endif // BLOCKVIEW_H
@@ -13,9 +13,10 @@
 #include <QMimeData>
 #include <QJsonDocument>
 #include <QGraphicsScene>
+#include <QtConcurrent>
 
-BlockCanvas::BlockCanvas(QGraphicsWidget* parent) : ScrollArea(parent) {
-    m_blockManager = new BlockManager;
+BlockCanvas::BlockCanvas(QGraphicsWidget* parent)
+        : ScrollArea(parent), m_blockManager{new BlockManager}, m_debugSession{m_blockManager} {
 
     this->setGrooveColor(QColor(Qt::transparent));
     this->setHandleColor(QColor("#4c4c4c"));
@@ -24,9 +25,20 @@ BlockCanvas::BlockCanvas(QGraphicsWidget* parent) : ScrollArea(parent) {
 
     connect(m_blockManager, &BlockManager::blockDeleted, this, &BlockCanvas::blockDeleted);
     connect(m_blockManager, &BlockManager::joinDeleted, this, &BlockCanvas::joinDeleted);
+
+    m_autoEvaluateTimer.setSingleShot(true);
+    m_autoEvaluateTimer.setInterval(300);
+    connect(&m_autoEvaluateTimer, &QTimer::timeout, this, &BlockCanvas::autoEvaluate);
+    connect(m_blockManager, &BlockManager::blockDirty, this, &BlockCanvas::scheduleAutoEvaluate);
+    connect(m_blockManager, &BlockManager::runToRequest, this, &BlockCanvas::debugRunTo);
+
+    m_progressTimer.setInterval(50);
+    connect(&m_progressTimer, &QTimer::timeout, this, &BlockCanvas::updateProgress);
+    connect(&m_evaluationWatcher, &QFutureWatcher<bool>::finished, this, &BlockCanvas::finishEvaluation);
 }
 
 BlockCanvas::~BlockCanvas() {
+    this->waitForEvaluation();
     delete m_blockManager;
 }
 
@@ -186,85 +198,38 @@ BlockPortView* BlockCanvas::portViewAtPos(QPointF pos) const {
 }
 
 bool BlockCanvas::schemeValidity() const {
-    bool valid = true;
-    for (auto block: m_blockManager->blocks().values())
-        valid = valid && block->validInputs();
-
-    return valid;
+    return m_blockManager->plan().inputsValid();
 }
 
 bool BlockCanvas::cycled() const {
-    QSet<Identifier> expansion, toBeExpanded, endBlocks, passed, notPassed;
-    notPassed = m_blockManager->blocks().keys().toSet();
+    return m_blockManager->plan().hasCycle();
+}
 
-    for (auto block: m_blockManager->blocks().values()) {
-        if (!block->outputPort()->isConnected())
-            endBlocks.insert(block->id());
+void BlockCanvas::highlightCycles() {
+    this->clearHighlights();
+    for (const auto &cycle: m_blockManager->plan().cycles()) {
+        for (Identifier blockId: cycle) {
+            m_blockManager->block(blockId)->view()->setHighlighted(true);
+            m_highlightedBlocks.append(blockId);
+        }
     }
+}
 
-    while (!notPassed.isEmpty()) {
-        Identifier blockId = notPassed.toList().at(0);
-        notPassed.remove(blockId);
-        bool expasionEnded = false;
-
-        expansion.clear();
-        expansion.insert(blockId);
-        passed.clear();
-
-        do {
-            notPassed -= expansion;
-            if (!(expansion & passed).isEmpty())
-                return true;
-            if ((expansion - endBlocks).isEmpty()) {
-                expasionEnded = true;
-                break;
-            }
-            passed |= expansion;
-
-            // expand
-            for (Identifier id: expansion)
-                toBeExpanded |= m_blockManager->blockBlocksOutputs(id);
-            expansion = toBeExpanded;
-            toBeExpanded.clear();
-
-        } while (!expasionEnded);
+void BlockCanvas::clearHighlights() {
+    for (Identifier blockId: m_highlightedBlocks) {
+        Block* block = m_blockManager->block(blockId);
+        if (block != nullptr)
+            block->view()->setHighlighted(false);
     }
-
-    return false;
+    m_highlightedBlocks.clear();
 }
 
 BlockManager* BlockCanvas::manager() const {
     return m_blockManager;
 }
 
-QList<Identifier> BlockCanvas::blockComputeOrder() {
-    QList<Identifier> computedBlocks;
-    while (computedBlocks.size() < m_blockManager->blocks().values().length()) {
-        for (auto block: m_blockManager->blocks().values()) {
-            if (computedBlocks.contains(block->id()))
-                continue;
-            const QSet<Identifier> blockOuts = m_blockManager->blockBlocksInputs(block->id());
-            bool blockEvaluable = blockOuts.isEmpty() ||
-                                  (blockOuts - computedBlocks.toSet()).isEmpty();
-            if (blockEvaluable)
-                computedBlocks.append(block->id());
-        }
-    }
-
-    return computedBlocks;
-}
-
 void BlockCanvas::evaluateBlock(Identifier blockId) {
-    Block* block = m_blockManager->block(blockId);
-    MappedDataValues res = block->evaluate(block->view()->values());
-    QList<QPair<Identifier, Identifier> > blocksTopropagate =
-            m_blockManager->blockOutputs(block->id());
-
-    block->outputPort()->setValue(res);
-    for (auto outData: blocksTopropagate) {
-        m_blockManager->blocks()[outData.first]->inputPorts()
-                .at(static_cast<int>(outData.second))->setValue(res);
-    }
+    m_blockManager->evaluateBlock(blockId);
 }
 
 void BlockCanvas::restoreHighlightPorts() {
@@ -286,8 +251,17 @@ void BlockCanvas::dishighlightPorts(Type::TypeE type) {
 }
 
 void BlockCanvas::evaluate() {
+    if (this->evaluating())
+        return;
+    if (m_debugSession.active()) {
+        this->debugContinue();
+        return;
+    }
+
     // check if ports are valid
+    this->clearHighlights();
     if (this->cycled()) {
+        this->highlightCycles();
         emit this->error(tr("Scheme has cycle."));
         return;
     }
@@ -298,46 +272,235 @@ void BlockCanvas::evaluate() {
     }
 
     // compute available blocks
-    for (Identifier blockId: this->blockComputeOrder())
-        this->evaluateBlock(blockId);
+    const bool large = m_blockManager->plan().order().length() >= BlockCanvas::s_minAsyncBlocks;
+    if (m_blockManager->resultsValid()) {
+        for (Identifier blockId: m_blockManager->dirtyOrder())
+            this->evaluateBlock(blockId);
+    } else if (m_engine == Sequential && !large) {
+        for (Identifier blockId: m_blockManager->plan().order())
+            this->evaluateBlock(blockId);
+    } else {
+        // compiled program has no blocks to attribute cost to
+        SchemeProgram* program = (m_engine == Compiled && !m_profiling) ? m_blockManager->program() : nullptr;
+        if (program != nullptr && program->length() >= BlockCanvas::s_minAsyncLength) {
+            this->startEvaluation(program);
+            return;
+        } else if (program != nullptr) {
+            program->loadInputs();
+            program->run();
+            program->publish(m_blockManager);
+        } else if (large) {
+            // profiling, sequential engine and schemes which cannot be compiled run on worker too
+            this->startBlocksEvaluation(m_engine != Sequential);
+            return;
+        } else
+            ParallelEvaluator{m_blockManager}.evaluate();
+    }
+    m_blockManager->setEvaluated();
+    this->updateHeatmap();
 }
 
-void BlockCanvas::debug() {
-    // check if ports are valid
+void BlockCanvas::startEvaluation(SchemeProgram* program) {
+    // inputs are read here in GUI thread, worker touches only its own copy of registers
+    program->loadInputs();
+    m_runningProgram = *program;
+    m_runningBlocks = false;
+    this->watchEvaluation(m_runningProgram.length(), [this]() {
+        return m_runningProgram.run(m_cancelEvaluation, m_evaluationProgress);
+    });
+}
+
+void BlockCanvas::startBlocksEvaluation(bool parallel) {
+    // inputs are copied here in GUI thread, worker calls blocks only through evaluation
+    m_runningEvaluator = ParallelEvaluator{m_blockManager};
+    m_runningEvaluator.setParallel(parallel);
+    m_runningEvaluator.load();
+    m_runningBlocks = true;
+    m_blockManager->setDisableDelete(true);
+    this->watchEvaluation(m_runningEvaluator.length(), [this]() {
+        return m_runningEvaluator.run(m_cancelEvaluation, m_evaluationProgress);
+    });
+}
+
+void BlockCanvas::watchEvaluation(int length, const std::function<bool()> &job) {
+    m_evaluationRevision = m_blockManager->revision();
+    m_evaluationLength = length;
+    m_cancelEvaluation.store(0);
+    m_evaluationProgress.store(0);
+
+    m_evaluationWatcher.setFuture(QtConcurrent::run(job));
+    m_progressTimer.start();
+    emit this->evaluationProgress(0);
+}
+
+void BlockCanvas::waitForEvaluation() {
+    m_cancelEvaluation.store(1);
+    m_evaluationWatcher.waitForFinished();
+    if (m_runningBlocks) {
+        m_runningBlocks = false;
+        m_blockManager->setDisableDelete(false);
+    }
+}
+
+void BlockCanvas::finishEvaluation() {
+    m_progressTimer.stop();
+    emit this->evaluationProgress(-1);
+    const bool runningBlocks = m_runningBlocks;
+    if (runningBlocks) {
+        m_runningBlocks = false;
+        m_blockManager->setDisableDelete(false);
+    }
+
+    if (!m_evaluationWatcher.result()) {
+        emit this->error(tr("Evaluation cancelled."));
+        return;
+    }
+    if (m_blockManager->revision() != m_evaluationRevision) {
+        emit this->error(tr("Scheme changed during evaluation."));
+        return;
+    }
+
+    if (runningBlocks)
+        m_runningEvaluator.publish();
+    else
+        m_runningProgram.publish(m_blockManager);
+    m_blockManager->setEvaluated();
+    this->updateHeatmap();
+}
+
+void BlockCanvas::updateProgress() {
+    if (m_evaluationLength > 0)
+        emit this->evaluationProgress(static_cast<int>(100. * m_evaluationProgress.load() / m_evaluationLength));
+}
+
+void BlockCanvas::cancelEvaluation() {
+    m_cancelEvaluation.store(1);
+}
+
+bool BlockCanvas::evaluating() const {
+    return m_evaluationWatcher.isRunning();
+}
+
+void BlockCanvas::autoEvaluate() {
+    if (!m_autoEvaluate || m_debugSession.active())
+        return;
+    if (this->cycled() || !this->schemeValidity())
+        return;
+    this->evaluate();
+}
+
+void BlockCanvas::scheduleAutoEvaluate() {
+    if (m_autoEvaluate)
+        m_autoEvaluateTimer.start();
+}
+
+void BlockCanvas::setEngine(BlockCanvas::Engine engine) {
+    m_engine = engine;
+}
+
+void BlockCanvas::setProfiling(bool v) {
+    m_profiling = v;
+    m_blockManager->setProfiling(v);
+    this->updateHeatmap();
+}
+
+void BlockCanvas::updateHeatmap() {
+    qint64 maxTime = 0;
+    for (auto block: m_blockManager->blocks())
+        maxTime = qMax(maxTime, block->profile().nanoseconds);
+
+    for (auto block: m_blockManager->blocks()) {
+        if (m_profiling && maxTime > 0)
+            block->view()->setCost(static_cast<double>(block->profile().nanoseconds) / maxTime);
+        else
+            block->view()->setCost(-1);
+    }
+}
+
+void BlockCanvas::setAutoEvaluate(bool v) {
+    m_autoEvaluate = v;
+    if (!v)
+        m_autoEvaluateTimer.stop();
+}
+
+bool BlockCanvas::startDebug() {
+    // scheme is validated only once, session keeps its order until stopped
     if (!this->schemeValidity()) {
         emit this->error(tr("Scheme has invalid inputs."));
-        return;
+        return false;
     }
 
+    this->clearHighlights();
     if (this->cycled()) {
+        this->highlightCycles();
         emit this->error(tr("Scheme has cycle."));
-        return;
+        return false;
     }
 
-    QList<Identifier> computeOrder = this->blockComputeOrder();
-    if (m_debugIteration >= computeOrder.length()) {
+    this->scene()->clearSelection();
+    m_blockManager->invalidateResults();
+    m_blockManager->setDisableDelete(true);
+    this->setDisableDrop(true);
+    m_debugSession.start();
+    emit this->debugStateChanged(true);
+    return true;
+}
+
+void BlockCanvas::showDebugPosition() {
+    this->scene()->clearSelection();
+    if (m_debugSession.position() > 0)
+        m_blockManager->block(m_debugSession.last())->view()->setSelected(true);
+    this->updateHeatmap();
+}
+
+void BlockCanvas::debug() {
+    if (this->evaluating())
+        return;
+    if (!m_debugSession.active() && !this->startDebug())
+        return;
+
+    if (m_debugSession.atEnd()) {
         this->stopDebug();
         return;
     }
+    m_debugSession.step();
+    this->showDebugPosition();
+}
 
-    if (m_debugIteration == 0)
-        this->scene()->clearSelection();
-    m_blockManager->setDisableDelete(true);
-    this->setDisableDrop(true);
+void BlockCanvas::debugContinue() {
+    if (this->evaluating())
+        return;
+    if (!m_debugSession.active() && !this->startDebug())
+        return;
 
-    Block* block = m_blockManager->block(computeOrder.at(m_debugIteration));
-    block->view()->setSelected(true);
+    if (m_debugSession.atEnd()) {
+        this->stopDebug();
+        return;
+    }
+    m_debugSession.continueToBreakpoint();
+    this->showDebugPosition();
+}
 
-    if (m_debugIteration > 0)
-        m_blockManager->block(computeOrder.at(m_debugIteration - 1))->view()->setSelected(false);
-    this->evaluateBlock(block->id());
+void BlockCanvas::debugRunTo(Identifier blockId) {
+    if (this->evaluating())
+        return;
+    if (!m_debugSession.active() && !this->startDebug())
+        return;
 
-    m_debugIteration++;
-    emit this->debugStateChanged(true);
+    if (!m_debugSession.runTo(blockId))
+        emit this->error(tr("Block was already evaluated."));
+    this->showDebugPosition();
+}
+
+void BlockCanvas::debugStepBack() {
+    if (!m_debugSession.active())
+        return;
+    m_debugSession.stepBack();
+    this->showDebugPosition();
 }
 
 void BlockCanvas::stopDebug() {
-    m_debugIteration = 0;
+    m_debugSession.stop();
     m_blockManager->setDisableDelete(false);
     this->scene()->clearSelection();
     this->setDisableDrop(false);
@@ -349,7 +512,6 @@ void BlockCanvas::setDisableDrop(bool v) {
 }
 
 void BlockCanvas::clear() {
-    QList<Identifier> blocks = m_blockManager->blocks().keys();
-    for (auto blockId: blocks)
-        m_blockManager->deleteBlock(blockId);
+    this->waitForEvaluation();
+    m_blockManager->clear();
 }
@@ -10,8 +10,14 @@
 #ifndef BLOCKCANVAS_H
 #define BLOCKCANVAS_H
 
+#include <QAtomicInt>
+#include <QFutureWatcher>
+#include <QTimer>
+#include <functional>
 #include "scrollarea.h"
 #include <app/core/blockmanager.h>
+#include <app/core/debugsession.h>
+#include <app/core/parallelevaluator.h>
 
 
 /**
@@ -19,15 +25,55 @@
  */
 class BlockCanvas : public ScrollArea {
     Q_OBJECT
+    public:
+        /**
+         * Engines for complete evaluation of scheme.
+         */
+        enum Engine {
+            Sequential,
+            Parallel,
+            Compiled
+        };
+
     private:
+        /**
+         * Programs shorter than this are run directly in GUI thread.
+         */
+        static constexpr int s_minAsyncLength = 10000;
+        /**
+         * Schemes with fewer blocks than this are evaluated block by block directly in GUI thread.
+         */
+        static constexpr int s_minAsyncBlocks = 1000;
+
         bool m_dragOver = false;
         QPointF m_portStartPoint = QPointF(-1, -1);
         QPointF m_portOrigStartPoint;
         QPointF m_portEndPoint = QPointF();
         bool m_drawLine = false;
         BlockManager* m_blockManager;
-        int m_debugIteration = 0;
+        DebugSession m_debugSession;
         bool m_disableDrop = false;
+        bool m_autoEvaluate = false;
+        bool m_profiling = false;
+        Engine m_engine = Compiled;
+        QTimer m_autoEvaluateTimer;
+        QList<Identifier> m_highlightedBlocks;
+
+        /**
+         * Snapshot of compiled scheme with loaded inputs, owned by worker thread while running.
+         */
+        SchemeProgram m_runningProgram;
+        /**
+         * Snapshot of inputs for evaluation by blocks, deletion of blocks is disabled while running.
+         */
+        ParallelEvaluator m_runningEvaluator;
+        bool m_runningBlocks = false;
+        int m_evaluationLength = 0;
+        QFutureWatcher<bool> m_evaluationWatcher;
+        QTimer m_progressTimer;
+        QAtomicInt m_cancelEvaluation;
+        QAtomicInt m_evaluationProgress;
+        quint64 m_evaluationRevision = 0;
 
     public:
         explicit BlockCanvas(QGraphicsWidget* parent = nullptr);
@@ -40,9 +86,6 @@ class BlockCanvas : public ScrollArea {
          */
         void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
 
-    private:
-        QList<Identifier> blockComputeOrder();
-
     protected:
         /**
          * Start of drag event.
@@ -93,6 +136,47 @@ class BlockCanvas : public ScrollArea {
          * @return state
          */
         bool cycled() const;
+        /**
+         * Highlights all blocks forming cycles in scheme.
+         */
+        void highlightCycles();
+        /**
+         * Removes all highlights from blocks.
+         */
+        void clearHighlights();
+        /**
+         * Validates scheme and starts debug session.
+         * @return false if scheme cannot be debugged
+         */
+        bool startDebug();
+        /**
+         * Selects last block evaluated by debug session.
+         */
+        void showDebugPosition();
+        /**
+         * Tints blocks by their profiled time relative to most expensive block.
+         */
+        void updateHeatmap();
+        /**
+         * Runs copy of program on worker thread, results are published after finish.
+         * @param program compiled scheme
+         */
+        void startEvaluation(SchemeProgram* program);
+        /**
+         * Runs blocks over snapshot of inputs on worker thread, results are published after finish.
+         * @param parallel spread wide levels over worker pool?
+         */
+        void startBlocksEvaluation(bool parallel);
+        /**
+         * Starts background evaluation and reports its progress.
+         * @param length count of steps reported by progress
+         * @param job evaluation run on worker thread, returns false if cancelled
+         */
+        void watchEvaluation(int length, const std::function<bool()> &job);
+        /**
+         * Cancels background evaluation and waits for it, so blocks may be deleted.
+         */
+        void waitForEvaluation();
 
     public:
         /**
@@ -100,6 +184,11 @@ class BlockCanvas : public ScrollArea {
          * @return block manager
          */
         BlockManager* manager() const;
+        /**
+         * Checks if evaluation runs in background.
+         * @return state
+         */
+        bool evaluating() const;
 
     private slots:
         /**
@@ -117,20 +206,68 @@ class BlockCanvas : public ScrollArea {
          * @param type compatible port
          */
         void dishighlightPorts(Type::TypeE type);
+        /**
+         * Reevaluates edited blocks after debounce, invalid scheme is skipped silently.
+         */
+        void autoEvaluate();
+        /**
+         * Schedules automatic reevaluation after edit of block.
+         */
+        void scheduleAutoEvaluate();
+        /**
+         * Publishes results of background evaluation, if scheme was not changed meanwhile.
+         */
+        void finishEvaluation();
+        /**
+         * Reports progress of background evaluation.
+         */
+        void updateProgress();
 
     public slots:
         /**
-         * Eval all blocks.
+         * Eval all blocks, only edited blocks and their successors, if previous results are valid.
          */
         void evaluate();
         /**
-         * Starts debug session.
+         * Sets flag to reevaluate scheme automatically on input edit.
+         * @param v state
+         */
+        void setAutoEvaluate(bool v);
+        /**
+         * Sets engine for complete evaluation, compiled engine falls back to parallel one.
+         * @param engine engine
+         */
+        void setEngine(Engine engine);
+        /**
+         * Enables profiling of blocks with heatmap overlay, compiled engine is not used while profiling.
+         * @param v state
+         */
+        void setProfiling(bool v);
+        /**
+         * Evaluates next block of debug session, session is started on first call.
          */
         void debug();
+        /**
+         * Evaluates blocks of debug session until block with breakpoint.
+         */
+        void debugContinue();
+        /**
+         * Evaluates blocks of debug session until given block.
+         * @param blockId target block
+         */
+        void debugRunTo(Identifier blockId);
+        /**
+         * Reverts last step of debug session.
+         */
+        void debugStepBack();
         /**
          * Stops debug session.
          */
         void stopDebug();
+        /**
+         * Requests stop of running background evaluation.
+         */
+        void cancelEvaluation();
 
         /**
          * Sets flag to disable drop.
@@ -149,6 +286,11 @@ class BlockCanvas : public ScrollArea {
          * @param debugging state
          */
         void debugStateChanged(bool debugging);
+        /**
+         * Progress of background evaluation.
+         * @param percent done part, -1 when evaluation ended
+         */
+        void evaluationProgress(int percent);
 
         /**
          * Display error of msg.
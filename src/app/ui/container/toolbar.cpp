@@ -8,6 +8,8 @@
  */
 
 #include "toolbar.h"
+#include <app/core/blockprofile.h>
+#include <app/ui/container/blockcanvas.h>
 #include <QGraphicsAnchorLayout>
 #include <QGraphicsLinearLayout>
 #include <QPainter>
@@ -18,13 +20,27 @@ ToolBar::ToolBar(QGraphicsItem* parent) : QGraphicsWidget(parent) {
     m_openButton = new TextButton{tr("Open"), this};
     m_saveButton = new TextButton{tr("Save"), this};
     m_saveAsButton = new TextButton{tr("Save As"), this};
+    m_exportButton = new TextButton{tr("Export"), this};
+    m_profileButton = new TextButton{tr("Profile"), this};
+    m_reportButton = new TextButton{tr("Report"), this};
+    m_autoButton = new TextButton{tr("Auto"), this};
+    m_cacheButton = new TextButton{tr("Cache"), this};
+    m_engine = BlockCanvas::Compiled;
+    m_engineButton = new TextButton{tr("Compiled"), this};
 
     m_newButton->setFont(QFont{"Montserrat", 18});
     m_openButton->setFont(m_newButton->font());
     m_saveButton->setFont(m_newButton->font());
     m_saveAsButton->setFont(m_newButton->font());
+    m_exportButton->setFont(m_newButton->font());
+    m_profileButton->setFont(m_newButton->font());
+    m_reportButton->setFont(m_newButton->font());
+    m_autoButton->setFont(m_newButton->font());
+    m_cacheButton->setFont(m_newButton->font());
+    m_engineButton->setFont(m_newButton->font());
 
     m_runButton = new IconButton{":/res/image/play_icon.svg", this};
+    m_debugBackButton = new IconButton{":/res/image/play_back_icon.svg", this};
     m_debugButton = new IconButton{":/res/image/play_iter_icon.svg", this};
     m_stopButton = new IconButton{":/res/image/stop_icon.svg", this};
     m_bugRenderer.load(QString{":/res/image/bug_icon.svg"});
@@ -42,9 +58,16 @@ ToolBar::ToolBar(QGraphicsItem* parent) : QGraphicsWidget(parent) {
     layout->addItem(m_openButton);
     layout->addItem(m_saveButton);
     layout->addItem(m_saveAsButton);
+    layout->addItem(m_exportButton);
+    layout->addItem(m_profileButton);
+    layout->addItem(m_reportButton);
+    layout->addItem(m_autoButton);
+    layout->addItem(m_cacheButton);
+    layout->addItem(m_engineButton);
     layout->addItem(subLayout);
 
     subLayout->addItem(m_runButton);
+    subLayout->addItem(m_debugBackButton);
     subLayout->addItem(m_debugButton);
     subLayout->addItem(m_stopButton);
 
@@ -55,7 +78,7 @@ ToolBar::ToolBar(QGraphicsItem* parent) : QGraphicsWidget(parent) {
     mainLayout->addCornerAnchors(mainLayout, Qt::BottomRightCorner,
                                  subLayout, Qt::BottomRightCorner);
 
-    this->setMinimumWidth(580 + 45);
+    this->setMinimumWidth(1250 + 2 * 45);
     this->setMinimumHeight(45);
     this->setMaximumHeight(45);
 
@@ -63,9 +86,16 @@ ToolBar::ToolBar(QGraphicsItem* parent) : QGraphicsWidget(parent) {
     connect(m_saveButton, &Clickable::clicked, this, &ToolBar::saveFile);
     connect(m_saveAsButton, &Clickable::clicked, this, &ToolBar::saveAsFile);
     connect(m_openButton, &Clickable::clicked, this, &ToolBar::openFile);
+    connect(m_exportButton, &Clickable::clicked, this, &ToolBar::exportFile);
+    connect(m_profileButton, &Clickable::clicked, this, &ToolBar::nextProfileKey);
+    connect(m_reportButton, &Clickable::clicked, this, &ToolBar::report);
+    connect(m_autoButton, &Clickable::clicked, this, &ToolBar::toggleAutoEvaluate);
+    connect(m_cacheButton, &Clickable::clicked, this, &ToolBar::toggleCache);
+    connect(m_engineButton, &Clickable::clicked, this, &ToolBar::nextEngine);
 
     connect(m_runButton, &Clickable::clicked, this, &ToolBar::evaluate);
     connect(m_debugButton, &Clickable::clicked, this, &ToolBar::debug);
+    connect(m_debugBackButton, &Clickable::clicked, this, &ToolBar::debugBack);
     connect(m_stopButton, &Clickable::clicked, this, &ToolBar::stop);
 }
 
@@ -98,6 +128,11 @@ void ToolBar::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, Q
         painter->drawRect(iconRect);
         m_bugRenderer.render(painter, iconRect.adjusted(5, 5, -5, -5));
     }
+    if (m_progress >= 0) {
+        painter->setPen(QColor(Qt::transparent));
+        painter->setBrush(QColor{"#0f81bc"});
+        painter->drawRect(QRectF(0, size.height() - 3, size.width() * m_progress / 100., 3));
+    }
 
     painter->restore();
 }
@@ -106,3 +141,58 @@ void ToolBar::setDebugIconVisiblity(bool v) {
     m_debugIconVisible = v;
     this->update();
 }
+
+void ToolBar::setProgress(int percent) {
+    m_progress = percent;
+    this->update();
+}
+
+void ToolBar::nextProfileKey() {
+    // off -> time -> calls -> allocations -> off
+    m_profileKey = (m_profileKey == BlockProfile::Allocations) ? -1 : m_profileKey + 1;
+
+    switch (m_profileKey) {
+        case BlockProfile::Time:
+            m_profileButton->setText(tr("By Time"));
+            break;
+        case BlockProfile::Calls:
+            m_profileButton->setText(tr("By Calls"));
+            break;
+        case BlockProfile::Allocations:
+            m_profileButton->setText(tr("By Allocs"));
+            break;
+        default:
+            m_profileButton->setText(tr("Profile"));
+    }
+    m_profileButton->setColor(m_profileKey >= 0 ? QColor{"#0f81bc"} : QColor{});
+    emit this->profilingChanged(m_profileKey);
+}
+
+void ToolBar::toggleAutoEvaluate() {
+    m_autoEvaluate = !m_autoEvaluate;
+    m_autoButton->setColor(m_autoEvaluate ? QColor{"#0f81bc"} : QColor{});
+    emit this->autoEvaluateChanged(m_autoEvaluate);
+}
+
+void ToolBar::toggleCache() {
+    m_cache = !m_cache;
+    m_cacheButton->setColor(m_cache ? QColor{"#0f81bc"} : QColor{});
+    emit this->cacheLimitChanged(m_cache ? ToolBar::s_cacheLimit : 0);
+}
+
+void ToolBar::nextEngine() {
+    // sequential -> parallel -> compiled -> sequential
+    m_engine = (m_engine == BlockCanvas::Compiled) ? BlockCanvas::Sequential : m_engine + 1;
+
+    switch (m_engine) {
+        case BlockCanvas::Sequential:
+            m_engineButton->setText(tr("Sequential"));
+            break;
+        case BlockCanvas::Parallel:
+            m_engineButton->setText(tr("Parallel"));
+            break;
+        default:
+            m_engineButton->setText(tr("Compiled"));
+    }
+    emit this->engineChanged(m_engine);
+}
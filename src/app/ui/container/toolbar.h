@@ -21,14 +21,28 @@
 class ToolBar : public QGraphicsWidget {
     Q_OBJECT
     private:
+        static constexpr int s_cacheLimit = 256;
+
         TextButton* m_newButton;
         TextButton* m_saveButton;
         TextButton* m_saveAsButton;
         TextButton* m_openButton;
+        TextButton* m_exportButton;
+        TextButton* m_profileButton;
+        TextButton* m_reportButton;
+        TextButton* m_autoButton;
+        TextButton* m_cacheButton;
+        TextButton* m_engineButton;
         IconButton* m_runButton;
         IconButton* m_debugButton;
+        IconButton* m_debugBackButton;
         IconButton* m_stopButton;
         bool m_debugIconVisible = false;
+        int m_progress = -1;
+        int m_profileKey = -1;
+        bool m_autoEvaluate = false;
+        bool m_cache = false;
+        int m_engine;
         QSvgRenderer m_bugRenderer;
 
     public:
@@ -46,6 +60,25 @@ class ToolBar : public QGraphicsWidget {
 
     public slots:
         void setDebugIconVisiblity(bool v);
+        void setProgress(int percent);
+
+    private slots:
+        /**
+         * Switches profiling off or to next sort key.
+         */
+        void nextProfileKey();
+        /**
+         * Switches automatic evaluation on edit.
+         */
+        void toggleAutoEvaluate();
+        /**
+         * Switches caching of block results.
+         */
+        void toggleCache();
+        /**
+         * Switches to next engine of complete evaluation.
+         */
+        void nextEngine();
 
     signals:
         /**
@@ -68,6 +101,10 @@ class ToolBar : public QGraphicsWidget {
          * Start debugging.
          */
         void debug();
+        /**
+         * Step back in debugging.
+         */
+        void debugBack();
         /**
          * Stop debugging.
          */
@@ -77,6 +114,35 @@ class ToolBar : public QGraphicsWidget {
          * Save schema as file.
          */
         void saveAsFile();
+        /**
+         * Export schema as C++ source.
+         */
+        void exportFile();
+
+        /**
+         * Profiling switched on or its sort key changed.
+         * @param key sort key of profiles, -1 if profiling is off
+         */
+        void profilingChanged(int key);
+        /**
+         * Show report of profiled blocks.
+         */
+        void report();
+        /**
+         * Automatic evaluation on edit switched.
+         * @param v state
+         */
+        void autoEvaluateChanged(bool v);
+        /**
+         * Caching of block results switched.
+         * @param entries count of cached results per block, zero if off
+         */
+        void cacheLimitChanged(int entries);
+        /**
+         * Engine of complete evaluation changed.
+         * @param engine value of BlockCanvas::Engine
+         */
+        void engineChanged(int engine);
 };
 
 #endif // TOOLBAR_H
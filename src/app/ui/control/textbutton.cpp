@@ -38,6 +38,10 @@ QColor TextButton::color() const {
     return m_color;
 }
 
+QString TextButton::text() const {
+    return m_text;
+}
+
 void TextButton::resizeToText() {
     QFontMetrics fm(m_font);
     QSizeF newGeometry = fm.boundingRect(m_text).size();
@@ -62,3 +66,12 @@ void TextButton::setColor(QColor color) {
     m_color = color;
     emit colorChanged(m_color);
 }
+
+void TextButton::setText(const QString &text) {
+    if (m_text == text)
+        return;
+
+    m_text = text;
+    this->resizeToText();
+    this->update();
+}
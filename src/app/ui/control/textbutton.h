@@ -65,6 +65,11 @@ class TextButton : public Clickable {
          * @return
          */
         QColor color() const;
+        /**
+         * Getter for text.
+         * @return text
+         */
+        QString text() const;
 
     private slots:
         void resizeToText();
@@ -80,6 +85,11 @@ class TextButton : public Clickable {
          * @param color new color
          */
         void setColor(QColor color);
+        /**
+         * Sets new text and resizes button to it.
+         * @param text new text
+         */
+        void setText(const QString &text);
 
     signals:
         /**
@@ -23,6 +23,7 @@ TextEditWithFixedText::TextEditWithFixedText(QGraphicsItem* parent) : QGraphicsW
     connect(this, &TextEditWithFixedText::fontChanged, m_fixedText, &QGraphicsTextItem::setFont);
     connect(m_textEdit, &TextEdit::currentBorderColorChanged, [this]() { this->update(); });
     connect(m_textEdit, &TextEdit::contentChanged, this, &TextEditWithFixedText::resizeToContent);
+    connect(m_textEdit, &TextEdit::contentChanged, this, &TextEditWithFixedText::textChanged);
     connect(m_fixedText->document(), &QTextDocument::contentsChanged,
             this, &TextEditWithFixedText::resizeToContent);
 }
@@ -156,6 +156,10 @@ class TextEditWithFixedText : public QGraphicsWidget {
          * @param font new font
          */
         void fontChanged(const QFont &font);
+        /**
+         * On change of editable text.
+         */
+        void textChanged();
 };
 
 #endif // TEXTEDITWITHFIXEDTEXT_H
@@ -37,16 +37,19 @@ JoinView::JoinView(Identifier dataId, QGraphicsItem* parent)
 }
 
 void JoinView::keyPressEvent(QKeyEvent* event) {
-    if (event->key() == Qt::Key_Delete) {
+    if (event->key() == Qt::Key_Delete && m_blockManager != nullptr) {
+        QSet<Identifier> blockIds;
+        QSet<Identifier> joinIds;
         for (auto item: this->scene()->selectedItems()) {
             auto blockView = dynamic_cast<BlockView*>(item);
             auto joinView = dynamic_cast<JoinView*>(item);
 
             if (blockView != nullptr)
-                    emit blockView->deleteRequest(blockView->blockData()->id());
+                blockIds.insert(blockView->blockData()->id());
             else if (joinView != nullptr)
-                    emit joinView->deleteRequest(joinView->dataId());
+                joinIds.insert(joinView->dataId());
         }
+        m_blockManager->deleteItems(blockIds, joinIds);
     }
 
     QGraphicsLineItem::keyPressEvent(event);
@@ -117,8 +120,9 @@ void JoinView::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
     if (m_blockManager != nullptr && m_blockManager->join(m_dataId) != nullptr) {
         painter->setOpacity(m_currentOpacity);
         Join* join = m_blockManager->join(m_dataId);
-        const QString value = m_blockManager->block(join->fromBlock())
-                ->outputPort()->view()->rawValue(true);
+        // read from core, hidden view of output port is refreshed lazily
+        const BlockPort* port = m_blockManager->block(join->fromBlock())->outputPort();
+        const QString value = QString("%1: %2").arg(Type::toString(port->type()), Type::format(port->value()));
         painter->setFont(QFont("Montserrat Light", 12));
 
         QFontMetrics fm{painter->font()};
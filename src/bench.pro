@@ -0,0 +1,25 @@
+#-------------------------------------------------
+#
+# Benchmarks of core operations over generated schemes.
+#
+#-------------------------------------------------
+
+include(app.pro)
+
+TARGET = blockbench
+
+DESTDIR = build
+OBJECTS_DIR = build/bench/.obj
+MOC_DIR = build/bench/.moc
+RCC_DIR = build/bench/.rcc
+UI_DIR = build/bench/.ui
+
+SOURCES -= \
+    app/main.cpp
+
+HEADERS += \
+    bench/schemegenerator.h
+
+SOURCES += \
+    bench/main.cpp \
+    bench/schemegenerator.cpp
@@ -0,0 +1,166 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <cstdio>
+#include <functional>
+#include <sys/resource.h>
+#include <app/core/blocks/blocks.h>
+#include <app/core/cycledetector.h>
+#include <app/core/parallelevaluator.h>
+#include <app/core/schemeio.h>
+#include <app/core/vectorkernels.h>
+#include "schemegenerator.h"
+
+/**
+ * Peak resident memory of process.
+ * @return memory in MiB
+ */
+static double peakMemory() {
+    struct rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.;
+}
+
+/**
+ * Runs operation and prints its time and throughput.
+ * @param out output stream
+ * @param name name of operation
+ * @param blocks count of blocks processed by operation
+ * @param operation measured operation
+ */
+static void measure(QTextStream &out, const QString &name, int blocks, const std::function<void()> &operation) {
+    QElapsedTimer timer;
+    timer.start();
+    operation();
+    const double seconds = qMax(timer.nsecsElapsed(), static_cast<qint64>(1)) / 1e9;
+
+    out << QString("  %1 %2 ms %3 blocks/s\n")
+            .arg(name, -12)
+            .arg(seconds * 1000., 12, 'f', 3)
+            .arg(blocks / seconds, 14, 'f', 0);
+    out.flush();
+}
+
+/**
+ * Benchmarks core operations over one generated scheme.
+ * @param out output stream
+ * @param scheme generated scheme
+ * @param blocks count of blocks
+ * @param cacheLimit count of cached results per block, zero disables cache
+ */
+static void benchmarkScheme(QTextStream &out, const QJsonObject &scheme, int blocks, int cacheLimit) {
+    BlockManager manager;
+    SchemeIO schemeIO{&manager};
+    manager.setCacheLimit(cacheLimit);
+
+    QByteArray serialized;
+    QJsonObject parsed;
+    measure(out, "serialize", blocks, [&]() { serialized = QJsonDocument{scheme}.toJson(); });
+    measure(out, "parse", blocks, [&]() { parsed = QJsonDocument::fromJson(serialized).object(); });
+    measure(out, "jsonValid", blocks, [&]() { schemeIO.jsonValid(parsed); });
+    measure(out, "load", blocks, [&]() { schemeIO.loadFromJson(parsed, nullptr); });
+    measure(out, "plan", blocks, [&]() { manager.plan(); });
+    measure(out, "cycled", blocks, [&]() { CycleDetector{&manager}.detect(); });
+
+    measure(out, "sequential", blocks, [&]() {
+        for (Identifier blockId: manager.plan().order())
+            manager.evaluateBlock(blockId);
+    });
+    measure(out, "parallel", blocks, [&]() { ParallelEvaluator{&manager}.evaluate(); });
+    if (cacheLimit > 0)
+        out << QString("  %1 %2 hits %3 misses\n").arg("cache", -12).arg(manager.cacheHits(), 12)
+                .arg(manager.cacheMisses());
+    measure(out, "compile", blocks, [&]() { manager.program(); });
+    measure(out, "compiled", blocks, [&]() {
+        SchemeProgram* program = manager.program();
+        if (program == nullptr)
+            return;
+        program->loadInputs();
+        program->run();
+        program->publish(&manager);
+    });
+    measure(out, "export", blocks, [&]() { schemeIO.exportToJson(); });
+
+    // blocks are owned by caller of loadFromJson
+    const QList<Block*> loaded = manager.blocks().values();
+    measure(out, "destroy", blocks, [&]() {
+        qDeleteAll(loaded);
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    });
+}
+
+int main(int argc, char* argv[]) {
+    QCoreApplication a(argc, argv);
+    // only core is measured, widgets of blocks would dominate
+    Block::setHeadless(true);
+
+    Block::registerBlock<AddBlock>(2);
+    Block::registerBlock<SubBlock>(2);
+    Block::registerBlock<MulBlock>(2);
+    Block::registerBlock<CosBlock>(1);
+    Block::registerBlock<SinBlock>(1);
+    Block::registerBlock<VectMagBlock>(1);
+    Block::registerBlock<VectInitBlock>(2);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    const QCommandLineOption shapesOption{"shapes", "Comma separated shapes: chain, wide, random.", "list",
+                                          "chain,wide,random"};
+    const QCommandLineOption sizesOption{"sizes", "Comma separated counts of blocks.", "list",
+                                         "1000,10000,100000,1000000"};
+    const QCommandLineOption seedOption{"seed", "Seed of random generator.", "number", "1"};
+    const QCommandLineOption saveOption{"save", "Save generated schemes into <directory>.", "directory"};
+    const QCommandLineOption cacheOption{"cache", "Cache <entries> results per block in sequential and parallel runs.",
+                                         "entries", "0"};
+    parser.addOption(shapesOption);
+    parser.addOption(sizesOption);
+    parser.addOption(seedOption);
+    parser.addOption(saveOption);
+    parser.addOption(cacheOption);
+    parser.process(a);
+
+    QTextStream out{stdout};
+    QTextStream err{stderr};
+    SchemeGenerator generator{parser.value(seedOption).toUInt()};
+    out << "vector kernels: " << VectorKernels::instructionSet() << endl;
+
+    for (const QString &shapeName: parser.value(shapesOption).split(',', QString::SkipEmptyParts)) {
+        bool ok;
+        const SchemeGenerator::Shape shape = SchemeGenerator::parseShape(shapeName, &ok);
+        if (!ok) {
+            err << "Unknown shape " << shapeName << endl;
+            return 1;
+        }
+
+        for (const QString &size: parser.value(sizesOption).split(',', QString::SkipEmptyParts)) {
+            const int blocks = size.toInt();
+            const QJsonObject scheme = generator.generate(shape, blocks);
+            out << SchemeGenerator::shapeName(shape) << " " << blocks << " blocks, "
+                << scheme["joins"].toArray().size() << " joins" << endl;
+
+            if (parser.isSet(saveOption)) {
+                QFile file{QDir{parser.value(saveOption)}.filePath(
+                        QString("%1_%2.bsf").arg(SchemeGenerator::shapeName(shape)).arg(blocks))};
+                if (file.open(QIODevice::WriteOnly))
+                    file.write(QJsonDocument{scheme}.toJson());
+            }
+
+            benchmarkScheme(out, scheme, blocks, parser.value(cacheOption).toInt());
+            out << QString("  %1 %2 MiB\n").arg("peak memory", -12).arg(peakMemory(), 12, 'f', 1) << endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,141 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#include "schemegenerator.h"
+
+#include <QtMath>
+#include <app/core/blocks/blocks.h>
+
+SchemeGenerator::SchemeGenerator(quint32 seed) : m_random{seed} {}
+
+int SchemeGenerator::addBlock(const QString &type) {
+    const int id = m_blocks.size();
+    const int inputs = Block::blockInputsCount(type);
+    // grid positions keep generated scheme readable when opened in editor
+    const int columns = qMax(1, static_cast<int>(qSqrt(m_blocks.size() + 1)));
+
+    QJsonArray values;
+    for (int i = 0; i < inputs; i++)
+        values.append(0.5);
+
+    m_blocks.append(QJsonObject{
+            {"id",           id},
+            {"type",         type},
+            {"input_values", values},
+            {"output_value", QJsonValue{}},
+            {"x",            (id % columns) * 150},
+            {"y",            (id / columns) * 100},
+    });
+    m_inputsCount.append(inputs);
+    return id;
+}
+
+void SchemeGenerator::addJoin(int fromBlock, int toBlock, int toPort) {
+    m_joins.append(QJsonObject{
+            {"fromBlock", fromBlock},
+            {"fromPort",  0},
+            {"toBlock",   toBlock},
+            {"toPort",    toPort},
+    });
+}
+
+QString SchemeGenerator::randomType() {
+    static const QStringList types{
+            AddBlock::staticClassId(),
+            SubBlock::staticClassId(),
+            MulBlock::staticClassId(),
+            SinBlock::staticClassId(),
+            CosBlock::staticClassId(),
+    };
+    return types.at(std::uniform_int_distribution<int>{0, types.length() - 1}(m_random));
+}
+
+void SchemeGenerator::generateChain(int blocks) {
+    for (int i = 0; i < blocks; i++) {
+        const int id = this->addBlock(this->randomType());
+        if (i > 0)
+            this->addJoin(id - 1, id, 0);
+    }
+}
+
+void SchemeGenerator::generateWide(int blocks) {
+    // one source fans out to half of blocks, which are summed back by binary tree
+    const int root = this->addBlock(SinBlock::staticClassId());
+    QList<int> frontier;
+    for (int i = 0; i < (blocks - 1) / 2; i++) {
+        const int id = this->addBlock(MulBlock::staticClassId());
+        this->addJoin(root, id, 0);
+        frontier.append(id);
+    }
+
+    while (frontier.length() > 1 && m_blocks.size() < blocks) {
+        QList<int> next;
+        for (int i = 0; i + 1 < frontier.length(); i += 2) {
+            const int id = this->addBlock(AddBlock::staticClassId());
+            this->addJoin(frontier.at(i), id, 0);
+            this->addJoin(frontier.at(i + 1), id, 1);
+            next.append(id);
+        }
+        if (frontier.length() % 2 == 1)
+            next.append(frontier.last());
+        frontier = next;
+    }
+
+    while (m_blocks.size() < blocks)
+        this->addBlock(CosBlock::staticClassId());
+}
+
+void SchemeGenerator::generateRandom(int blocks) {
+    std::bernoulli_distribution connected{0.7};
+    for (int i = 0; i < blocks; i++) {
+        const int id = this->addBlock(this->randomType());
+        for (int port = 0; port < m_inputsCount.at(id) && id > 0; port++) {
+            if (connected(m_random))
+                this->addJoin(std::uniform_int_distribution<int>{0, id - 1}(m_random), id, port);
+        }
+    }
+}
+
+QJsonObject SchemeGenerator::generate(SchemeGenerator::Shape shape, int blocks) {
+    m_blocks = QJsonArray{};
+    m_joins = QJsonArray{};
+    m_inputsCount.clear();
+
+    if (shape == Chain)
+        this->generateChain(blocks);
+    else if (shape == Wide)
+        this->generateWide(blocks);
+    else
+        this->generateRandom(blocks);
+
+    return QJsonObject{
+            {"blocks", m_blocks},
+            {"joins",  m_joins},
+    };
+}
+
+SchemeGenerator::Shape SchemeGenerator::parseShape(const QString &name, bool* ok) {
+    *ok = true;
+    if (name == "chain")
+        return Chain;
+    else if (name == "wide")
+        return Wide;
+    else if (name == "random")
+        return Random;
+    *ok = false;
+    return Chain;
+}
+
+QString SchemeGenerator::shapeName(SchemeGenerator::Shape shape) {
+    if (shape == Chain)
+        return "chain";
+    else if (shape == Wide)
+        return "wide";
+    return "random";
+}
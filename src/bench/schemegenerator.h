@@ -0,0 +1,91 @@
+/**
+ * Part of block editor project for ICP at FIT BUT 2017-2018.
+ *
+ * @package ICP-2017-2018
+ * @authors Son Hai Nguyen xnguye16@stud.fit.vutbr.cz, Josef Kolář xkolar71@stud.fit.vutbr.cz
+ * @date 06-05-2018
+ * @version 1.0
+ */
+
+#ifndef SCHEMEGENERATOR_H
+#define SCHEMEGENERATOR_H
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+#include <random>
+
+/**
+ * Generates synthetic acyclic schemes in format of saved files.
+ */
+class SchemeGenerator {
+    public:
+        /**
+         * Shapes of generated scheme.
+         */
+        enum Shape {
+            Chain,
+            Wide,
+            Random
+        };
+
+    private:
+        std::mt19937 m_random;
+        QJsonArray m_blocks;
+        QJsonArray m_joins;
+        QList<int> m_inputsCount;
+
+        /**
+         * Appends block with all inputs set to literal value.
+         * @param type class id of block
+         * @return id of new block
+         */
+        int addBlock(const QString &type);
+        /**
+         * Appends join from output of one block to input port of other.
+         * @param fromBlock source block
+         * @param toBlock target block
+         * @param toPort input port of target block
+         */
+        void addJoin(int fromBlock, int toBlock, int toPort);
+        /**
+         * Random scalar block type.
+         * @return class id
+         */
+        QString randomType();
+
+        void generateChain(int blocks);
+        void generateWide(int blocks);
+        void generateRandom(int blocks);
+
+    public:
+        /**
+         * Creates generator.
+         * @param seed seed of random generator
+         */
+        explicit SchemeGenerator(quint32 seed = 1);
+
+        /**
+         * Generates scheme.
+         * @param shape shape of scheme
+         * @param blocks count of blocks
+         * @return scheme in format of saved file
+         */
+        QJsonObject generate(Shape shape, int blocks);
+
+        /**
+         * Parses shape name.
+         * @param name chain, wide or random
+         * @param ok set to false for unknown name
+         * @return shape
+         */
+        static Shape parseShape(const QString &name, bool* ok);
+        /**
+         * Name of shape.
+         * @param shape shape
+         * @return name
+         */
+        static QString shapeName(Shape shape);
+};
+
+#endif // SCHEMEGENERATOR_H